@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "detail/char_classes.h"
+#include "token_reader.h"
+#include "uri_parser.h"
+
+namespace {
+
+// Comparison chains the parser used before the lookup table,
+// kept here as the baseline.
+bool IsAlphaChain(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool IsDigitChain(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool IsSubDelimsChain(char c) {
+    return (c == '!') || (c == '$') || (c == '&') || (c == '\'') ||
+           (c == '(') || (c == ')') || (c == '*') || (c == '+') ||
+           (c == ',') || (c == ';') || (c == '=');
+}
+
+bool IsUnreservedChain(char c) {
+    return IsAlphaChain(c) || IsDigitChain(c) ||
+           (c == '-') || (c == '.') ||
+           (c == '_') || (c == '~');
+}
+
+bool IsPcharChain(char c) {
+    return IsUnreservedChain(c) || IsSubDelimsChain(c) ||
+           (c == ':') || (c == '@');
+}
+
+std::string GenerateQueryLikeText(size_t length) {
+    static constexpr char kAlphabet[] =
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-._~!$&'()*+,;=:@";
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> distribution(0, sizeof(kAlphabet) - 2);
+
+    std::string text;
+    text.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+        text.push_back(kAlphabet[distribution(generator)]);
+    }
+    return text;
+}
+
+void BM_PcharComparisonChain(benchmark::State& state) {
+    const auto& text = GenerateQueryLikeText(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        size_t matched = 0;
+        for (char c: text) {
+            matched += IsPcharChain(c) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_PcharLookupTable(benchmark::State& state) {
+    const auto& text = GenerateQueryLikeText(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        size_t matched = 0;
+        for (char c: text) {
+            matched += uri::__internal::HasCharClass(c, uri::__internal::kPchar) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_QueryFragmentRule(benchmark::State& state) {
+    const auto& text = GenerateQueryLikeText(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        uri::__internal::TokenReader reader(text);
+        std::optional<std::string_view> value;
+        benchmark::DoNotOptimize(uri::__internal::queryFragment(reader, value));
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_PcharComparisonChain)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(BM_PcharLookupTable)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(BM_QueryFragmentRule)->Arg(64)->Arg(512)->Arg(4096);
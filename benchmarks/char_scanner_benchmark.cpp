@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "detail/char_scanner.h"
+#include "uri_view.h"
+
+namespace {
+
+std::string GenerateQuery(size_t length) {
+    static constexpr char kAlphabet[] =
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-._~=&";
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<size_t> distribution(0, sizeof(kAlphabet) - 2);
+
+    std::string query;
+    query.reserve(length);
+    while (query.length() < length) {
+        // Sprinkle a few percent-encoded bytes.
+        if (query.length() % 37 == 36) {
+            query += "%2F";
+            continue;
+        }
+        query.push_back(kAlphabet[distribution(generator)]);
+    }
+    return query;
+}
+
+void BM_ScanQueryScalar(benchmark::State& state) {
+    const auto& query = GenerateQuery(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(uri::__internal::ScanCharClassScalar(query, uri::__internal::kQueryFragmentSet));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_ScanQueryVector(benchmark::State& state) {
+    const auto& query = GenerateQuery(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(uri::__internal::ScanCharClass(query, uri::__internal::kQueryFragmentSet));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_ParseUriWithLongQuery(benchmark::State& state) {
+    const auto& uri = "https://example.com/search/results?" + GenerateQuery(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(uri::UriView::parse(uri));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uri.length()));
+}
+
+} // namespace
+
+BENCHMARK(BM_ScanQueryScalar)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(BM_ScanQueryVector)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(BM_ParseUriWithLongQuery)->Arg(64)->Arg(512)->Arg(4096);
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "concurrent_uri_set.h"
+#include "uri.h"
+#include "uri_corpus.h"
+
+namespace {
+
+constexpr size_t kCorpusSize = 1 << 16;
+
+const std::vector<uri::Uri>& Corpus() {
+    static const std::vector<uri::Uri> uris = []() {
+        std::vector<uri::Uri> parsed;
+        for (const auto& input: uri_benchmarks::GenerateUriCorpus(kCorpusSize)) {
+            auto uri = uri::Uri::parse(input);
+            if (uri) {
+                parsed.push_back(std::move(uri.value()));
+            }
+        }
+        return parsed;
+    }();
+    return uris;
+}
+
+// What a "seen" set usually is: normal forms behind a mutex.
+struct MutexGuardedSet {
+    std::mutex mutex;
+    std::unordered_set<std::string> uris;
+};
+
+std::unique_ptr<MutexGuardedSet> mutex_guarded_set;
+std::unique_ptr<uri::ConcurrentUriSet> concurrent_set;
+
+// Every thread inserts every URI, starting from its own share of the
+// corpus, so threads both insert new URIs and find ones seen by others.
+void BM_MutexGuardedSet(benchmark::State& state) {
+    const auto& uris = Corpus();
+    if (state.thread_index() == 0) {
+        mutex_guarded_set = std::make_unique<MutexGuardedSet>();
+    }
+
+    size_t index = uris.size() * static_cast<size_t>(state.thread_index()) / static_cast<size_t>(state.threads());
+    for (auto _: state) {
+        const std::string normalised(uris[index].normalised().toString());
+        {
+            std::lock_guard<std::mutex> lock(mutex_guarded_set->mutex);
+            benchmark::DoNotOptimize(mutex_guarded_set->uris.insert(normalised));
+        }
+        index = (index + 1) % uris.size();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        mutex_guarded_set.reset();
+    }
+}
+
+void BM_ConcurrentUriSet(benchmark::State& state) {
+    const auto& uris = Corpus();
+    if (state.thread_index() == 0) {
+        concurrent_set = std::make_unique<uri::ConcurrentUriSet>();
+    }
+
+    size_t index = uris.size() * static_cast<size_t>(state.thread_index()) / static_cast<size_t>(state.threads());
+    for (auto _: state) {
+        benchmark::DoNotOptimize(concurrent_set->insertIfAbsent(uris[index], static_cast<uint32_t>(index)));
+        index = (index + 1) % uris.size();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        concurrent_set.reset();
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_MutexGuardedSet)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ConcurrentUriSet)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "uri.h"
+#include "uri_corpus.h"
+
+namespace {
+
+std::vector<uri::Uri> ParseCorpus(size_t count) {
+    std::vector<uri::Uri> uris;
+    for (const auto& input: uri_benchmarks::GenerateUriCorpus(count)) {
+        auto uri = uri::Uri::parse(input);
+        if (uri) {
+            uris.push_back(std::move(uri.value()));
+        }
+    }
+    return uris;
+}
+
+// Hashing the streamed URI, as done without std::hash<uri::Uri>.
+void BM_HashStreamed(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        size_t hash = 0;
+        for (const auto& uri: uris) {
+            std::ostringstream stream;
+            stream << uri;
+            hash ^= std::hash<std::string>()(stream.str());
+        }
+        benchmark::DoNotOptimize(hash);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+void BM_HashCached(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        size_t hash = 0;
+        for (const auto& uri: uris) {
+            hash ^= std::hash<uri::Uri>()(uri);
+        }
+        benchmark::DoNotOptimize(hash);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+void BM_Fingerprint(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        for (const auto& uri: uris) {
+            benchmark::DoNotOptimize(uri.getFingerprint());
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+// The normal form built, then hashed.
+void BM_NormalisedThenHashed(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        uint64_t hash = 0;
+        for (const auto& uri: uris) {
+            hash ^= uri.normalised().getHash();
+        }
+        benchmark::DoNotOptimize(hash);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+void BM_NormalisedHash(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        uint64_t hash = 0;
+        for (const auto& uri: uris) {
+            hash ^= uri.getNormalisedHash();
+        }
+        benchmark::DoNotOptimize(hash);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_HashStreamed)->Arg(4096);
+BENCHMARK(BM_HashCached)->Arg(4096);
+BENCHMARK(BM_Fingerprint)->Arg(4096);
+BENCHMARK(BM_NormalisedThenHashed)->Arg(4096);
+BENCHMARK(BM_NormalisedHash)->Arg(4096);
@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "uri_corpus.h"
+#include "uri_view.h"
+
+namespace {
+
+std::vector<std::string> GenerateValidCorpus() {
+    auto corpus = uri_benchmarks::GenerateUriCorpus(10000);
+    std::vector<std::string> valid;
+    for (auto& input: corpus) {
+        if (uri::UriView::parse(input)) {
+            valid.push_back(std::move(input));
+        }
+    }
+    return valid;
+}
+
+// Successful parses, the cost of error tracking should not be measurable.
+void BM_ParseValid(benchmark::State& state) {
+    const auto& corpus = GenerateValidCorpus();
+
+    for (auto _: state) {
+        for (const auto& input: corpus) {
+            benchmark::DoNotOptimize(uri::UriView::parse(input));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(corpus.size()));
+}
+
+void BM_TryParseValid(benchmark::State& state) {
+    const auto& corpus = GenerateValidCorpus();
+
+    for (auto _: state) {
+        for (const auto& input: corpus) {
+            benchmark::DoNotOptimize(uri::UriView::tryParse(input));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(corpus.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_ParseValid);
+BENCHMARK(BM_TryParseValid);
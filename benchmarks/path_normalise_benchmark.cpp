@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "path_utils.h"
+
+namespace {
+
+const std::string kCleanPath = "/static/assets/images/icons/large/navigation/arrow-left.png";
+const std::string kDottedPath = "/a/b/c/./../../g/./h/%7Euser/../docs/%2e/guide/../index.html";
+
+// The segment based chain the library used to have.
+std::string NormaliseWithSegments(const std::string& path) {
+    const std::vector<std::string> segments =
+        uri::path::RemoveDotSegments(uri::path::SplitHierarchicalSegments(uri::path::CodeIfNecessary(path)));
+
+    std::stringstream out;
+    for (size_t i = 0; i < segments.size(); i++) {
+        out << segments[i];
+        if (i < segments.size() - 1) {
+            out << '/';
+        }
+    }
+    return out.str();
+}
+
+void BM_NormaliseWithSegments(benchmark::State& state, const std::string& path) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(NormaliseWithSegments(path));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(path.length()));
+}
+
+void BM_Normalise(benchmark::State& state, const std::string& path) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(uri::path::Normalise(path));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(path.length()));
+}
+
+void BM_NormaliseInPlace(benchmark::State& state, const std::string& path) {
+    std::string buffer;
+    buffer.reserve(path.length());
+
+    for (auto _: state) {
+        // Reuses the capacity of the buffer.
+        buffer.assign(path);
+        uri::path::NormaliseInPlace(buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(path.length()));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_NormaliseWithSegments, Clean, kCleanPath);
+BENCHMARK_CAPTURE(BM_Normalise, Clean, kCleanPath);
+BENCHMARK_CAPTURE(BM_NormaliseInPlace, Clean, kCleanPath);
+BENCHMARK_CAPTURE(BM_NormaliseWithSegments, Dotted, kDottedPath);
+BENCHMARK_CAPTURE(BM_Normalise, Dotted, kDottedPath);
+BENCHMARK_CAPTURE(BM_NormaliseInPlace, Dotted, kDottedPath);
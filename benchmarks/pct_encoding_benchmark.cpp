@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "pct_encoding.h"
+
+namespace {
+
+// Mostly clean text with a few escaped bytes and a UTF-8 word.
+const std::string kMixedText = "/search/results?q=uniform%20resource%20identifier%20parser&lang=%E6%97%A5%E6%9C%AC%E8%AA%9E&page=12";
+// A fully escaped UTF-8 text.
+const std::string kEscapedText = "%D0%9F%D1%80%D0%B8%D0%B2%D0%B5%D1%82%2C%20%D0%BC%D0%B8%D1%80%21%20%D0%9F%D1%80%D0%B8%D0%B2%D0%B5%D1%82";
+
+// The stream based decoder the library used to have.
+std::string DecodeWithStream(const std::string& input) {
+    auto hex = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+
+    std::stringstream out;
+    for (size_t i = 0; i < input.length(); i++) {
+        if (input[i] == '%' && i + 2 < input.length() && hex(input[i + 1]) >= 0 && hex(input[i + 2]) >= 0) {
+            out << static_cast<char>(hex(input[i + 1]) * 16 + hex(input[i + 2]));
+            i += 2;
+        } else {
+            out << input[i];
+        }
+    }
+    return out.str();
+}
+
+void BM_DecodeWithStream(benchmark::State& state, const std::string& text) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(DecodeWithStream(text));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.length()));
+}
+
+void BM_Decode(benchmark::State& state, const std::string& text) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(uri::decode(text));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.length()));
+}
+
+void BM_EncodeQueryParam(benchmark::State& state) {
+    const std::string& text = uri::decode(kMixedText);
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(uri::encode<uri::EncodeSet::kQueryParam>(text));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.length()));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_DecodeWithStream, Mixed, kMixedText);
+BENCHMARK_CAPTURE(BM_Decode, Mixed, kMixedText);
+BENCHMARK_CAPTURE(BM_DecodeWithStream, Escaped, kEscapedText);
+BENCHMARK_CAPTURE(BM_Decode, Escaped, kEscapedText);
+BENCHMARK(BM_EncodeQueryParam);
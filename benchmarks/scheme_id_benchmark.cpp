@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "uri.h"
+#include "uri_corpus.h"
+
+namespace {
+
+std::vector<uri::Uri> ParseCorpus(size_t count) {
+    std::vector<uri::Uri> uris;
+    for (const auto& input: uri_benchmarks::GenerateUriCorpus(count)) {
+        auto uri = uri::Uri::parse(input);
+        if (uri) {
+            uris.push_back(std::move(uri.value()));
+        }
+    }
+    return uris;
+}
+
+bool EqualsIgnoringCase(std::string_view text, std::string_view lowercase) {
+    if (text.length() != lowercase.length()) {
+        return false;
+    }
+    for (size_t i = 0; i < text.length(); i++) {
+        const char c = (text[i] >= 'A' && text[i] <= 'Z') ? static_cast<char>(text[i] - 'A' + 'a') : text[i];
+        if (c != lowercase[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Routing on the scheme text, as done without SchemeId.
+void BM_DispatchOnSchemeText(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        uint64_t routes = 0;
+        for (const auto& uri: uris) {
+            const auto scheme = uri.getScheme();
+            if (!scheme) {
+                continue;
+            }
+            if (EqualsIgnoringCase(scheme.value(), "https")) {
+                routes += 1;
+            } else if (EqualsIgnoringCase(scheme.value(), "http")) {
+                routes += 2;
+            } else if (EqualsIgnoringCase(scheme.value(), "ftp")) {
+                routes += 3;
+            }
+        }
+        benchmark::DoNotOptimize(routes);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+void BM_DispatchOnSchemeId(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        uint64_t routes = 0;
+        for (const auto& uri: uris) {
+            switch (uri.getSchemeId()) {
+                case uri::SchemeId::kHttps:
+                    routes += 1;
+                    break;
+                case uri::SchemeId::kHttp:
+                    routes += 2;
+                    break;
+                case uri::SchemeId::kFtp:
+                    routes += 3;
+                    break;
+                default:
+                    break;
+            }
+        }
+        benchmark::DoNotOptimize(routes);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_DispatchOnSchemeText)->Arg(4096);
+BENCHMARK(BM_DispatchOnSchemeId)->Arg(4096);
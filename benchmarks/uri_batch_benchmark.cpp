@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "uri.h"
+#include "uri_batch.h"
+#include "uri_corpus.h"
+
+namespace {
+
+void BM_ParseUrisOneByOne(benchmark::State& state) {
+    const auto& corpus = uri_benchmarks::GenerateUriCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _: state) {
+        size_t valid = 0;
+        for (const auto& input: corpus) {
+            const auto& uri = uri::Uri::parse(input);
+            valid += uri.has_value();
+            benchmark::DoNotOptimize(uri);
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_ParseUriBatch(benchmark::State& state) {
+    const auto& corpus = uri_benchmarks::GenerateUriCorpus(static_cast<size_t>(state.range(0)));
+    const std::vector<std::string_view> inputs(corpus.begin(), corpus.end());
+
+    uri::UriBatch batch;
+    for (auto _: state) {
+        uri::parseBatch(inputs.data(), inputs.size(), batch);
+        benchmark::DoNotOptimize(batch.getValidityBitmap().data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_ParseUrisOneByOne)->Arg(10000)->Arg(1000000);
+BENCHMARK(BM_ParseUriBatch)->Arg(10000)->Arg(1000000);
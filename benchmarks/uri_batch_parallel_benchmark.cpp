@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "uri_batch.h"
+#include "uri_corpus.h"
+
+namespace {
+
+constexpr size_t kCorpusSize = 1000000;
+
+void BM_ParseUriBatchParallel(benchmark::State& state) {
+    static const auto& corpus = uri_benchmarks::GenerateUriCorpus(kCorpusSize);
+    static const std::vector<std::string_view> inputs(corpus.begin(), corpus.end());
+
+    uri::UriBatch batch;
+    for (auto _: state) {
+        uri::parseBatchParallel(inputs.data(), inputs.size(), batch, static_cast<size_t>(state.range(0)));
+        benchmark::DoNotOptimize(batch.getValidityBitmap().data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kCorpusSize));
+}
+
+// Scaling from a single thread up to every available core.
+void ThreadsCounts(benchmark::internal::Benchmark* benchmark) {
+    const int64_t cores = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    for (int64_t threads = 1; threads < cores; threads *= 2) {
+        benchmark->Arg(threads);
+    }
+    benchmark->Arg(cores);
+}
+
+} // namespace
+
+BENCHMARK(BM_ParseUriBatchParallel)->Apply(ThreadsCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,64 @@
+#ifndef __URIC_BENCHMARKS_URI_CORPUS_H__
+#define __URIC_BENCHMARKS_URI_CORPUS_H__
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace uri_benchmarks {
+
+// A deterministic mix of URI references resembling access logs,
+// with a small share of invalid ones.
+inline std::vector<std::string> GenerateUriCorpus(size_t count) {
+    static const char* kHosts[] = {
+        "example.com", "api.service.internal", "192.168.10.24", "[2001:db8::1]", "cdn.example.org"
+    };
+    static const char* kSchemes[] = { "https", "http", "ftp" };
+    static const char* kSegments[] = {
+        "v1", "users", "items", "search", "static", "img", "a%20b", "index.html"
+    };
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> pick(0, 1023);
+
+    std::vector<std::string> corpus;
+    corpus.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        std::string uri;
+        if (pick(generator) % 8 != 0) {
+            uri += kSchemes[pick(generator) % 3];
+            uri += "://";
+            if (pick(generator) % 5 == 0) {
+                uri += "user:token@";
+            }
+            uri += kHosts[pick(generator) % 5];
+            if (pick(generator) % 3 == 0) {
+                uri += ":8080";
+            }
+        }
+
+        const size_t segments = 1 + pick(generator) % 4;
+        for (size_t s = 0; s < segments; s++) {
+            uri += '/';
+            uri += kSegments[pick(generator) % 8];
+        }
+
+        if (pick(generator) % 2 == 0) {
+            uri += "?id=" + std::to_string(pick(generator)) + "&sort=desc";
+        }
+        if (pick(generator) % 10 == 0) {
+            uri += "#section";
+        }
+        // Every 50th reference is broken.
+        if (i % 50 == 49) {
+            uri += " %zz";
+        }
+
+        corpus.push_back(std::move(uri));
+    }
+    return corpus;
+}
+
+} // namespace uri_benchmarks
+
+#endif // __URIC_BENCHMARKS_URI_CORPUS_H__
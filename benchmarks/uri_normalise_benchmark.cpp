@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "uri.h"
+#include "uri_corpus.h"
+
+namespace {
+
+std::vector<uri::Uri> ParseCorpus(size_t count, bool uppercase_hosts) {
+    std::vector<uri::Uri> uris;
+    for (auto input: uri_benchmarks::GenerateUriCorpus(count)) {
+        if (uppercase_hosts) {
+            // "HTTPS://EXAMPLE.COM/...", the rest stays as it is.
+            const size_t path = input.find('/', input.find("//") + 2);
+            for (size_t i = 0; i < path && i < input.length(); i++) {
+                input[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(input[i])));
+            }
+        }
+
+        auto uri = uri::Uri::parse(input);
+        if (uri) {
+            uris.push_back(std::move(uri.value()));
+        }
+    }
+    return uris;
+}
+
+void BM_Normalised(benchmark::State& state, bool uppercase_hosts) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)), uppercase_hosts);
+
+    for (auto _: state) {
+        for (const auto& uri: uris) {
+            benchmark::DoNotOptimize(uri.normalised());
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+void BM_IsNormalised(benchmark::State& state) {
+    const auto& uris = ParseCorpus(static_cast<size_t>(state.range(0)), /* uppercase_hosts= */ false);
+
+    for (auto _: state) {
+        size_t normal = 0;
+        for (const auto& uri: uris) {
+            normal += uri.isNormalised();
+        }
+        benchmark::DoNotOptimize(normal);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(uris.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_IsNormalised)->Arg(4096);
+BENCHMARK_CAPTURE(BM_Normalised, AlreadyNormal, false)->Arg(4096);
+BENCHMARK_CAPTURE(BM_Normalised, UppercaseHosts, true)->Arg(4096);
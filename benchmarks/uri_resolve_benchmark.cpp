@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "resolved_base.h"
+#include "uri.h"
+
+namespace {
+
+constexpr char kPageUri[] = "https://www.example.com/docs/guide/install/linux.html?lang=en";
+
+// Links of a typical page: relative, rooted, network-path and absolute ones.
+const std::vector<std::string> kHrefs = {
+    "../reference/index.html", "./windows.html", "macos.html#requirements", "/", "/blog/2024/release-notes",
+    "//cdn.example.com/assets/app.css", "https://github.com/example/project", "?lang=de", "#top",
+    "../../faq/../support/contact.html", "images/screenshot-1.png", "/docs/api/v2/resources/users?page=2",
+};
+
+void BM_ResolveWithUri(benchmark::State& state) {
+    const auto base = uri::Uri::parse(kPageUri).value();
+
+    for (auto _: state) {
+        for (const auto& href: kHrefs) {
+            benchmark::DoNotOptimize(uri::Uri::resolve(base, uri::Uri::parse(href).value()));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kHrefs.size()));
+}
+
+void BM_ResolveWithResolvedBase(benchmark::State& state) {
+    const auto base = uri::ResolvedBase::parse(kPageUri).value();
+
+    for (auto _: state) {
+        for (const auto& href: kHrefs) {
+            benchmark::DoNotOptimize(base.resolve(href));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kHrefs.size()));
+}
+
+void BM_Relativize(benchmark::State& state) {
+    const auto base = uri::ResolvedBase::parse(kPageUri).value();
+
+    std::vector<uri::Uri> targets;
+    for (const auto& href: kHrefs) {
+        targets.push_back(base.resolve(href).value());
+    }
+
+    for (auto _: state) {
+        for (const auto& target: targets) {
+            benchmark::DoNotOptimize(base.relativize(target));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(targets.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_ResolveWithUri);
+BENCHMARK(BM_ResolveWithResolvedBase);
+BENCHMARK(BM_Relativize);
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "query_view.h"
+#include "url.h"
+
+namespace {
+
+const std::string kQuery = "utm_source=newsletter&utm_medium=email&utm_campaign=spring&page=3&sort=desc&q=uri+parser";
+
+// A handler that reads a single parameter,
+// Url builds all the parameters up front.
+void BM_QueryParamsLookup(benchmark::State& state) {
+    for (auto _: state) {
+        const uri::Url url("/search", kQuery);
+        benchmark::DoNotOptimize(url.getQuery().find("page"));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void BM_QueryViewLookup(benchmark::State& state) {
+    for (auto _: state) {
+        const uri::QueryView view(kQuery);
+        benchmark::DoNotOptimize(view.find("page"));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// A proxy that forwards the Url without reading the parameters.
+void BM_UrlForward(benchmark::State& state) {
+    const std::string input = "http://example.com/search?" + kQuery;
+
+    for (auto _: state) {
+        auto url = uri::Url::parse(input);
+        benchmark::DoNotOptimize(uri::Url(std::move(url.value())));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+} // namespace
+
+BENCHMARK(BM_QueryParamsLookup);
+BENCHMARK(BM_QueryViewLookup);
+BENCHMARK(BM_UrlForward);
@@ -1,35 +1,54 @@
 #ifndef __URIC_AUTHORITY_H__
 #define __URIC_AUTHORITY_H__
 
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <string_view>
+
+#include "authority_view.h"
+#include "ip_address.h"
 
 namespace {
 
 using optional_string_t = std::optional<std::string>;
 
-constexpr char kUserInfoSeparator = '@';
-constexpr char kPortSeparator = ':';
-constexpr char kIPLiteralBegin = '[';
-constexpr char kIPLiteralEnd = ']';
-
 } // namespace
 
 namespace uri {
 
 class Authority {
 public:
-    static std::optional<Authority> parse(const std::string& input);
-
-    Authority(const std::string& host,
-              const optional_string_t& port = std::nullopt,
-              const optional_string_t& userInfo = std::nullopt,
-              bool is_host_ip_literal = false) noexcept:
-        _userInfo(userInfo),
-        _host(host),
-        _is_host_ip_literal(is_host_ip_literal),
-        _port(port) {
+    // Every component is allocated with the allocator,
+    // e.g. in a std::pmr::monotonic_buffer_resource.
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    static std::optional<Authority> parse(std::string_view input,
+                                          const allocator_type& allocator = allocator_type());
+
+    Authority(std::string_view host,
+              const optional_string_view_t& port = std::nullopt,
+              const optional_string_view_t& userInfo = std::nullopt,
+              bool is_host_ip_literal = false,
+              const allocator_type& allocator = allocator_type()) noexcept:
+        Authority(AuthorityView(host, port, userInfo, is_host_ip_literal), allocator) {
+        // Empty on purpose.
+    }
+
+    // Takes the values the view has already decoded, if any.
+    explicit Authority(const AuthorityView& view,
+                       const allocator_type& allocator = allocator_type()) noexcept:
+        _userInfo(copyOptional(view.getUserInfo(), allocator)),
+        _host(view.getHost(), allocator),
+        _is_host_ip_literal(view.isHostIPLiteral()),
+        _ipv4(view.getIPv4()),
+        _ipv6(view.getIPv6()),
+        _port(copyOptional(view.getPort(), allocator)),
+        _port_number(view.getPortNumber()),
+        _hash(hashOf(view.getHost(), view.getPort(), view.getUserInfo(), view.isHostIPLiteral())) {
         // Empty on purpose.
     }
 
@@ -38,8 +57,14 @@ public:
     Authority(Authority&& that) noexcept = default;
     Authority& operator=(Authority&& that) noexcept = default;
 
+    Authority(const Authority& that, const allocator_type& allocator) noexcept:
+        Authority(that.toView(), allocator) {
+        // Empty on purpose.
+    }
+
     bool operator==(const Authority& that) const {
-        return (_userInfo == that._userInfo)
+        return (_hash == that._hash)
+        && (_userInfo == that._userInfo)
         && (_host == that._host)
         && (_is_host_ip_literal == that._is_host_ip_literal)
         && (_port == that._port);
@@ -49,49 +74,102 @@ public:
         return !operator==(that);
     }
 
-    friend std::ostream& operator<<(std::ostream& stream, const Authority& that) { 
-        if (that._userInfo) {
-            stream << that._userInfo.value() << kUserInfoSeparator;
-        }
+    friend std::ostream& operator<<(std::ostream& stream, const Authority& that) {
+        return stream << that.toView();
+    }
 
-        if (that._is_host_ip_literal) {
-            stream << kIPLiteralBegin;
-        }
+    inline optional_string_view_t getUserInfo() const {
+        return _userInfo ? optional_string_view_t(_userInfo.value()) : std::nullopt;
+    }
 
-        stream << that._host;
+    inline std::string_view getHost() const {
+        return _host;
+    }
 
-        if (that._is_host_ip_literal) {
-            stream << kIPLiteralEnd;
-        }
+    inline bool isHostIPLiteral() const {
+        return _is_host_ip_literal;
+    }
 
-        if (that._port) {
-            stream << kPortSeparator << that._port.value();
-        }
+    // The address of an IPv4 host, other hosts have none.
+    inline const std::optional<IPv4Address>& getIPv4() const {
+        return _ipv4;
+    }
 
-        return stream;
+    // The address of an IPv6 host, IPvFuture and other hosts have none.
+    inline const std::optional<IPv6Address>& getIPv6() const {
+        return _ipv6;
     }
 
-    inline const optional_string_t& getUserInfo() const {
-        return _userInfo;
+    // RFC5952 text of the IPv6 host, e.g. "2001:db8::1" for "2001:DB8:0:0::1".
+    inline std::optional<std::string> getCanonicalIPv6() const {
+        return _ipv6 ? std::make_optional(ToString(_ipv6.value())) : std::nullopt;
     }
 
-    inline const std::string& getHost() const {
-        return _host;
+    inline optional_string_view_t getPort() const {
+        return _port ? optional_string_view_t(_port.value()) : std::nullopt;
+    }
+
+    // The port as a number, empty ports and ports
+    // out of the 16-bit range have none.
+    inline const std::optional<uint16_t>& getPortNumber() const {
+        return _port_number;
+    }
+
+    // Hash of the serialised authority, computed once
+    // the authority is built. Not cryptographic.
+    inline uint64_t getHash() const {
+        return _hash;
+    }
+
+    inline AuthorityView toView() const {
+        return AuthorityView(getHost(), getPort(), getUserInfo(), _is_host_ip_literal,
+                             _ipv4, _ipv6, _port_number);
     }
 
-    inline const optional_string_t& getPort() const {
-        return _port;
+    inline allocator_type get_allocator() const {
+        return _host.get_allocator();
     }
 
     ~Authority() = default;
 
 private:
-    optional_string_t _userInfo;
-    std::string _host;
+    using optional_pmr_string_t = std::optional<std::pmr::string>;
+
+    optional_pmr_string_t _userInfo;
+    std::pmr::string _host;
     bool _is_host_ip_literal;
-    optional_string_t _port;
+    // Decoded once, so addresses compare without parsing.
+    std::optional<IPv4Address> _ipv4;
+    std::optional<IPv6Address> _ipv6;
+    optional_pmr_string_t _port;
+    std::optional<uint16_t> _port_number;
+    uint64_t _hash;
+
+    static uint64_t hashOf(std::string_view host,
+                           const optional_string_view_t& port,
+                           const optional_string_view_t& userInfo,
+                           bool is_host_ip_literal);
+
+    static optional_pmr_string_t copyOptional(const optional_string_view_t& value,
+                                              const allocator_type& allocator) {
+        if (!value) {
+            return std::nullopt;
+        }
+        return std::make_optional<std::pmr::string>(value.value(), allocator);
+    }
 };
 
 } // namespace uri
 
+namespace std {
+
+template<>
+struct hash<uri::Authority> {
+    size_t operator()(const uri::Authority& authority) const noexcept {
+        return static_cast<size_t>(authority.getHash());
+    }
+};
+
+} // namespace std
+
 #endif // __URIC_AUTHORITY_H__
@@ -0,0 +1,166 @@
+#ifndef __URIC_AUTHORITY_VIEW_H__
+#define __URIC_AUTHORITY_VIEW_H__
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#include "ip_address.h"
+
+namespace {
+
+using optional_string_view_t = std::optional<std::string_view>;
+
+constexpr char kUserInfoSeparator = '@';
+constexpr char kPortSeparator = ':';
+constexpr char kIPLiteralBegin = '[';
+constexpr char kIPLiteralEnd = ']';
+
+} // namespace
+
+namespace uri {
+
+// Non-owning counterpart of Authority.
+// All components point into the buffer the view
+// has been parsed from, therefore the buffer
+// should outlive the view.
+//
+// Views made by the parsers, Uri and Authority carry the addresses
+// and the port number decoded along the way, other views decode
+// them from the text on request.
+class AuthorityView {
+public:
+    static std::optional<AuthorityView> parse(std::string_view input);
+
+    constexpr AuthorityView(std::string_view host,
+                            const optional_string_view_t& port = std::nullopt,
+                            const optional_string_view_t& userInfo = std::nullopt,
+                            bool is_host_ip_literal = false) noexcept:
+        _userInfo(userInfo),
+        _host(host),
+        _is_host_ip_literal(is_host_ip_literal),
+        _port(port),
+        _decoded(false),
+        _ipv4(),
+        _ipv6(),
+        _port_number() {
+        // Empty on purpose.
+    }
+
+    // Same as above, but with the values already decoded from the text.
+    constexpr AuthorityView(std::string_view host,
+                            const optional_string_view_t& port,
+                            const optional_string_view_t& userInfo,
+                            bool is_host_ip_literal,
+                            const std::optional<IPv4Address>& ipv4,
+                            const std::optional<IPv6Address>& ipv6,
+                            const std::optional<uint16_t>& port_number) noexcept:
+        _userInfo(userInfo),
+        _host(host),
+        _is_host_ip_literal(is_host_ip_literal),
+        _port(port),
+        _decoded(true),
+        _ipv4(ipv4),
+        _ipv6(ipv6),
+        _port_number(port_number) {
+        // Empty on purpose.
+    }
+
+    constexpr AuthorityView(const AuthorityView& that) noexcept = default;
+    constexpr AuthorityView& operator=(const AuthorityView& that) noexcept = default;
+    constexpr AuthorityView(AuthorityView&& that) noexcept = default;
+    constexpr AuthorityView& operator=(AuthorityView&& that) noexcept = default;
+
+    // The decoded values follow from the text, so they are not compared.
+    bool operator==(const AuthorityView& that) const {
+        return (_userInfo == that._userInfo)
+        && (_host == that._host)
+        && (_is_host_ip_literal == that._is_host_ip_literal)
+        && (_port == that._port);
+    }
+
+    bool operator!=(const AuthorityView& that) const {
+        return !operator==(that);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const AuthorityView& that) {
+        if (that._userInfo) {
+            stream << that._userInfo.value() << kUserInfoSeparator;
+        }
+
+        if (that._is_host_ip_literal) {
+            stream << kIPLiteralBegin;
+        }
+
+        stream << that._host;
+
+        if (that._is_host_ip_literal) {
+            stream << kIPLiteralEnd;
+        }
+
+        if (that._port) {
+            stream << kPortSeparator << that._port.value();
+        }
+
+        return stream;
+    }
+
+    inline constexpr const optional_string_view_t& getUserInfo() const {
+        return _userInfo;
+    }
+
+    inline constexpr std::string_view getHost() const {
+        return _host;
+    }
+
+    inline constexpr bool isHostIPLiteral() const {
+        return _is_host_ip_literal;
+    }
+
+    inline constexpr const optional_string_view_t& getPort() const {
+        return _port;
+    }
+
+    // The address of an IPv4 host, other hosts have none.
+    inline std::optional<IPv4Address> getIPv4() const {
+        if (_decoded) {
+            return _ipv4;
+        }
+        return _is_host_ip_literal ? std::nullopt : ParseIPv4Address(_host);
+    }
+
+    // The address of an IPv6 host, IPvFuture and other hosts have none.
+    inline std::optional<IPv6Address> getIPv6() const {
+        if (_decoded) {
+            return _ipv6;
+        }
+        return _is_host_ip_literal ? ParseIPv6Address(_host) : std::nullopt;
+    }
+
+    // The port as a number, empty ports and ports
+    // out of the 16-bit range have none.
+    inline std::optional<uint16_t> getPortNumber() const {
+        if (_decoded) {
+            return _port_number;
+        }
+        return _port ? ParsePortNumber(_port.value()) : std::nullopt;
+    }
+
+    ~AuthorityView() = default;
+
+private:
+    optional_string_view_t _userInfo;
+    std::string_view _host;
+    bool _is_host_ip_literal;
+    optional_string_view_t _port;
+    // Whether the values below have been decoded, see the constructors.
+    bool _decoded;
+    std::optional<IPv4Address> _ipv4;
+    std::optional<IPv6Address> _ipv6;
+    std::optional<uint16_t> _port_number;
+};
+
+} // namespace uri
+
+#endif // __URIC_AUTHORITY_VIEW_H__
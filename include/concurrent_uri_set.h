@@ -0,0 +1,91 @@
+#ifndef __URIC_CONCURRENT_URI_SET_H__
+#define __URIC_CONCURRENT_URI_SET_H__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "fingerprint.h"
+#include "uri.h"
+
+namespace uri {
+
+// Set of URIs shared by many threads, e.g. the URIs a crawler
+// has already seen, keyed by the fingerprints of their normal forms:
+// URIs equal once normalised are the same URI for the set.
+//
+// Every URI is stored with a handle chosen by the caller, e.g. the index
+// of the URI in the caller's own storage, the URIs themselves are not kept.
+//
+// Insertions and lookups are lock-free: slots of the open-addressing
+// table are single words published with compare-and-swap. A table half
+// full is followed by one twice as large, and the insertions that come
+// next move the slots over a chunk at a time while the others keep
+// finding and inserting URIs, so growing never stops the world.
+// Retired tables are only freed with the set, as lookups may still be
+// reading them; together they are never larger than the current table.
+//
+// Up to 2^32 - 2 URIs can be inserted.
+class ConcurrentUriSet {
+public:
+    using Handle = uint32_t;
+
+    // Room for |capacity| URIs before the set grows.
+    explicit ConcurrentUriSet(size_t capacity = 0);
+
+    ConcurrentUriSet(const ConcurrentUriSet& that) = delete;
+    ConcurrentUriSet& operator=(const ConcurrentUriSet& that) = delete;
+
+    // Inserts the URI with the handle unless an equivalent URI is already
+    // there. Returns the handle of the URI in the set and whether it was
+    // inserted, as std::unordered_set::insert does.
+    std::pair<Handle, bool> insertIfAbsent(const Uri& uri, Handle handle);
+    // Same as above for a fingerprint of Uri::getNormalisedFingerprint.
+    std::pair<Handle, bool> insertIfAbsent(const Fingerprint& fingerprint, Handle handle);
+
+    // The handle of the URI equivalent to |uri|, if there is one.
+    std::optional<Handle> find(const Uri& uri) const;
+    std::optional<Handle> find(const Fingerprint& fingerprint) const;
+
+    // The number of inserted URIs.
+    inline size_t size() const {
+        return _size.load(std::memory_order_relaxed);
+    }
+
+    ~ConcurrentUriSet();
+
+private:
+    struct Entry {
+        Fingerprint fingerprint;
+        Handle handle;
+    };
+
+    struct Table;
+
+    // Entries are allocated in segments twice as large as the previous
+    // one, so they never move once they are published.
+    static constexpr size_t kSegmentsCount = 23;
+
+    std::atomic<Table*> _current;
+    Table* _first;
+    std::array<std::atomic<Entry*>, kSegmentsCount> _segments;
+    std::atomic<uint32_t> _entries_count;
+    std::atomic<size_t> _size;
+
+    const Entry& entryOf(uint64_t slot) const;
+    uint64_t allocateEntry(const Fingerprint& fingerprint, uint64_t tag, Handle handle);
+
+    uint64_t publish(Table* table, const Fingerprint& fingerprint, uint64_t& value, Handle handle);
+    bool matches(uint64_t slot, uint64_t tag, const Fingerprint& fingerprint) const;
+
+    Table* grow(Table* table);
+    void helpMigrate(Table* table);
+    void migrateSlot(Table* table, size_t index);
+};
+
+} // namespace uri
+
+#endif // __URIC_CONCURRENT_URI_SET_H__
@@ -0,0 +1,130 @@
+#ifndef __URIC_CHAR_CLASSES_H__
+#define __URIC_CHAR_CLASSES_H__
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace uri {
+
+namespace __internal {
+
+// Character classes of RFC3986, see Appendix A.
+// Every byte is mapped to a bitmask of the classes it belongs to,
+// so classification is a single table load and a mask test.
+// Percent-encoded triplets are not a part of any class:
+// rules are expected to check "%" HEXDIG HEXDIG on their own.
+using char_class_t = uint16_t;
+
+inline constexpr char_class_t kAlpha = 1U << 0;
+inline constexpr char_class_t kDigit = 1U << 1;
+inline constexpr char_class_t kHexDigit = 1U << 2;
+// unreserved = ALPHA / DIGIT / "-" / "." / "_" / "~"
+inline constexpr char_class_t kUnreserved = 1U << 3;
+// sub-delims = "!" / "$" / "&" / "'" / "(" / ")" / "*" / "+" / "," / ";" / "="
+inline constexpr char_class_t kSubDelims = 1U << 4;
+// gen-delims = ":" / "/" / "?" / "#" / "[" / "]" / "@"
+inline constexpr char_class_t kGenDelims = 1U << 5;
+// pchar = unreserved / sub-delims / ":" / "@"
+inline constexpr char_class_t kPchar = 1U << 6;
+// query, fragment = *( pchar / "/" / "?" )
+inline constexpr char_class_t kQueryFragment = 1U << 7;
+// scheme = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." ), without the first letter.
+inline constexpr char_class_t kScheme = 1U << 8;
+// userinfo = *( unreserved / sub-delims / ":" )
+inline constexpr char_class_t kUserInfo = 1U << 9;
+// reg-name = *( unreserved / sub-delims )
+inline constexpr char_class_t kRegName = 1U << 10;
+// segment-nz-nc = 1*( unreserved / sub-delims / "@" )
+inline constexpr char_class_t kSegmentNc = 1U << 11;
+// Path characters: *( pchar / "/" ).
+inline constexpr char_class_t kPath = 1U << 12;
+// Key or value of a query item: query characters without "&", "=" and "+".
+inline constexpr char_class_t kQueryParam = 1U << 13;
+// Scheme and host characters in the normal case, see section 6.2.2.1:
+// reg-name and IP-literal characters without uppercase letters.
+inline constexpr char_class_t kLowercaseHost = 1U << 14;
+
+inline constexpr char_class_t kReserved = kGenDelims | kSubDelims;
+
+constexpr void AddClass(std::array<char_class_t, 256>& table,
+                        std::string_view symbols,
+                        char_class_t char_class) {
+    for (char c: symbols) {
+        table[static_cast<uint8_t>(c)] |= char_class;
+    }
+}
+
+constexpr void AddClassFrom(std::array<char_class_t, 256>& table,
+                            char_class_t from,
+                            char_class_t char_class) {
+    for (size_t i = 0; i < table.size(); i++) {
+        if ((table[i] & from) != 0) {
+            table[i] |= char_class;
+        }
+    }
+}
+
+constexpr void RemoveClass(std::array<char_class_t, 256>& table,
+                           std::string_view symbols,
+                           char_class_t char_class) {
+    for (char c: symbols) {
+        table[static_cast<uint8_t>(c)] &= static_cast<char_class_t>(~char_class);
+    }
+}
+
+constexpr std::array<char_class_t, 256> MakeCharClassesTable() {
+    std::array<char_class_t, 256> table{};
+
+    AddClass(table, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", kAlpha);
+    AddClass(table, "0123456789", kDigit);
+    // The uppercase hexadecimal digits 'A' through 'F' are equivalent to
+    // the lowercase digits 'a' through 'f', respectively.
+    AddClass(table, "0123456789abcdefABCDEF", kHexDigit);
+    AddClass(table, "!$&'()*+,;=", kSubDelims);
+    AddClass(table, ":/?#[]@", kGenDelims);
+
+    AddClassFrom(table, kAlpha | kDigit, kUnreserved);
+    AddClass(table, "-._~", kUnreserved);
+
+    AddClassFrom(table, kUnreserved | kSubDelims, kPchar);
+    AddClass(table, ":@", kPchar);
+
+    AddClassFrom(table, kPchar, kQueryFragment);
+    AddClass(table, "/?", kQueryFragment);
+
+    AddClassFrom(table, kAlpha | kDigit, kScheme);
+    AddClass(table, "+-.", kScheme);
+
+    AddClassFrom(table, kUnreserved | kSubDelims, kUserInfo);
+    AddClass(table, ":", kUserInfo);
+
+    AddClassFrom(table, kUnreserved | kSubDelims, kRegName);
+
+    AddClassFrom(table, kUnreserved | kSubDelims, kSegmentNc);
+    AddClass(table, "@", kSegmentNc);
+
+    AddClassFrom(table, kPchar, kPath);
+    AddClass(table, "/", kPath);
+
+    AddClassFrom(table, kQueryFragment, kQueryParam);
+    RemoveClass(table, "&=+", kQueryParam);
+
+    AddClassFrom(table, kRegName, kLowercaseHost);
+    AddClass(table, ":", kLowercaseHost);
+    RemoveClass(table, "ABCDEFGHIJKLMNOPQRSTUVWXYZ", kLowercaseHost);
+
+    return table;
+}
+
+inline constexpr std::array<char_class_t, 256> kCharClasses = MakeCharClassesTable();
+
+inline constexpr bool HasCharClass(char c, char_class_t char_class) {
+    return (kCharClasses[static_cast<uint8_t>(c)] & char_class) != 0;
+}
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_CHAR_CLASSES_H__
@@ -0,0 +1,63 @@
+#ifndef __URIC_CHAR_SCANNER_H__
+#define __URIC_CHAR_SCANNER_H__
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "char_classes.h"
+
+namespace uri {
+
+namespace __internal {
+
+// A character class prepared for block-wise classification.
+// Bytes are classified 16 at a time with two nibble lookups:
+// |low_nibbles| maps a low nibble to the set of high nibbles (rows)
+// that form bytes of the class, a byte belongs to the class
+// if its own row is in that set. Only ASCII can be in a class,
+// so 8 rows are enough.
+// The percent sign is added to the sets that accept percent-encoded
+// triplets to let the kernels check the triplets separately.
+// Sets without triplets stop at every percent sign.
+struct CharClassSet {
+    char_class_t char_class;
+    std::array<uint8_t, 16> low_nibbles;
+    bool pct_encoded;
+};
+
+constexpr CharClassSet MakeCharClassSet(char_class_t char_class, bool pct_encoded = true) {
+    CharClassSet set{ char_class, {}, pct_encoded };
+
+    for (size_t i = 0; i < 128; i++) {
+        if ((kCharClasses[i] & char_class) != 0 || (pct_encoded && i == '%')) {
+            set.low_nibbles[i & 0x0F] |= static_cast<uint8_t>(1U << (i >> 4));
+        }
+    }
+
+    return set;
+}
+
+inline constexpr CharClassSet kPcharSet = MakeCharClassSet(kPchar);
+inline constexpr CharClassSet kQueryFragmentSet = MakeCharClassSet(kQueryFragment);
+inline constexpr CharClassSet kUserInfoSet = MakeCharClassSet(kUserInfo);
+inline constexpr CharClassSet kRegNameSet = MakeCharClassSet(kRegName);
+inline constexpr CharClassSet kSegmentNcSet = MakeCharClassSet(kSegmentNc);
+inline constexpr CharClassSet kPathSet = MakeCharClassSet(kPath);
+inline constexpr CharClassSet kLowercaseHostSet = MakeCharClassSet(kLowercaseHost);
+
+// Returns the length of the longest prefix of |text| that
+// consists of bytes of |set| and valid percent-encoded triplets,
+// i.e. matches *( <set> / pct-encoded ), or only of bytes of |set|
+// when the set does not accept triplets.
+// Uses SSSE3 or AVX2 kernels when the CPU supports them.
+size_t ScanCharClass(std::string_view text, const CharClassSet& set);
+
+// Byte-at-a-time reference of ScanCharClass.
+size_t ScanCharClassScalar(std::string_view text, const CharClassSet& set);
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_CHAR_SCANNER_H__
@@ -0,0 +1,479 @@
+#ifndef __URIC_IP_RECOGNIZERS_H__
+#define __URIC_IP_RECOGNIZERS_H__
+
+#include <array>
+#include <cstdint>
+
+#include "char_classes.h"
+
+namespace uri {
+
+namespace __internal {
+
+// Incremental recognizers of IPv4address and IP-literal contents.
+// They are fed one byte at a time and never look back,
+// so they work on the input in a single left-to-right pass.
+
+// dec-octet = DIGIT / %x31-39 DIGIT / "1" 2DIGIT / "2" %x30-34 DIGIT / "25" %x30-35
+// In other words: 1 to 3 digits, without leading zeroes, not greater than 255.
+class DecOctetAccumulator {
+public:
+    constexpr DecOctetAccumulator() noexcept:
+        _digits(0),
+        _value(0),
+        _leading_zero(false),
+        _decimal(true) {
+        // Empty on purpose.
+    }
+
+    constexpr void reset() {
+        *this = DecOctetAccumulator();
+    }
+
+    constexpr void add(char c) {
+        if (!HasCharClass(c, kDigit)) {
+            _decimal = false;
+            return;
+        }
+
+        if (_digits == 0) {
+            _leading_zero = (c == '0');
+        }
+
+        // Values longer than 4 digits are never valid,
+        // stop accumulating to avoid overflows.
+        if (_digits < 4) {
+            _value = static_cast<uint16_t>(_value * 10 + (c - '0'));
+            _digits += 1;
+        }
+    }
+
+    constexpr bool isValid() const {
+        return _decimal &&
+               _digits >= 1 && _digits <= 3 &&
+               !(_leading_zero && _digits > 1) &&
+               _value <= 255;
+    }
+
+    constexpr uint8_t value() const {
+        return static_cast<uint8_t>(_value);
+    }
+
+private:
+    uint8_t _digits;
+    uint16_t _value;
+    bool _leading_zero;
+    bool _decimal;
+};
+
+// IPv4address = dec-octet "." dec-octet "." dec-octet "." dec-octet
+// The address is accumulated along the way, see value.
+class IPv4Recognizer {
+public:
+    constexpr IPv4Recognizer() noexcept:
+        _octet(),
+        _dots(0),
+        _failed(false),
+        _value(0) {
+        // Empty on purpose.
+    }
+
+    constexpr void reset() {
+        *this = IPv4Recognizer();
+    }
+
+    // Starts recognition with an already accumulated first octet.
+    constexpr void resetWithOctet(const DecOctetAccumulator& octet) {
+        reset();
+        _octet = octet;
+    }
+
+    // Returns false once the input cannot be an IPv4 address anymore.
+    constexpr bool feed(char c) {
+        if (_failed) {
+            return false;
+        }
+
+        if (c == '.') {
+            if (!_octet.isValid() || _dots == 3) {
+                _failed = true;
+                return false;
+            }
+
+            _dots += 1;
+            _value = (_value << 8) | _octet.value();
+            _octet.reset();
+            return true;
+        }
+
+        if (!HasCharClass(c, kDigit)) {
+            _failed = true;
+            return false;
+        }
+
+        _octet.add(c);
+        return true;
+    }
+
+    constexpr bool hasFailed() const {
+        return _failed;
+    }
+
+    constexpr bool finish() const {
+        return !_failed && _dots == 3 && _octet.isValid();
+    }
+
+    // The address in host byte order, should only be called when finish() is true.
+    constexpr uint32_t value() const {
+        return (_value << 8) | _octet.value();
+    }
+
+private:
+    DecOctetAccumulator _octet;
+    uint8_t _dots;
+    bool _failed;
+    // Completed octets.
+    uint32_t _value;
+};
+
+// port = *DIGIT
+// Accumulates the port number, which should fit into 16 bits.
+class PortDecoder {
+public:
+    constexpr PortDecoder() noexcept:
+        _value(0),
+        _failed(false) {
+        // Empty on purpose.
+    }
+
+    // Returns false once the input cannot be a port number anymore.
+    constexpr bool feed(char c) {
+        if (_failed || !HasCharClass(c, kDigit)) {
+            _failed = true;
+            return false;
+        }
+
+        _value = _value * 10 + static_cast<uint32_t>(c - '0');
+        // Leading zeroes do not count, the value is checked instead of the length.
+        if (_value > 0xFFFF) {
+            _failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    constexpr bool hasFailed() const {
+        return _failed;
+    }
+
+    constexpr uint16_t value() const {
+        return static_cast<uint16_t>(_value);
+    }
+
+private:
+    uint32_t _value;
+    bool _failed;
+};
+
+// IP-literal = "[" ( IPv6address / IPvFuture  ) "]"
+// Recognizes the content between the brackets.
+//
+// All nine IPv6address alternatives of RFC3986 are equivalent to:
+// groups of 1 to 4 HEXDIG separated by ":", where the last two groups
+// can be replaced by an IPv4address, and where at most one "::" can
+// stand for the omitted groups. Without "::" there should be exactly
+// 8 groups, with "::" there should be at most 7.
+//
+// IPvFuture = "v" 1*HEXDIG "." 1*( unreserved / sub-delims / ":" )
+class IPLiteralRecognizer {
+public:
+    constexpr IPLiteralRecognizer() noexcept:
+        _mode(Mode::kStart),
+        _groups(0),
+        _group_digits(0),
+        _colons(0),
+        _double_colon(false),
+        _group_octet(),
+        _ipv4() {
+        // Empty on purpose.
+    }
+
+    constexpr void reset() {
+        *this = IPLiteralRecognizer();
+    }
+
+    // Returns false once the input cannot be an IP-literal anymore.
+    constexpr bool feed(char c) {
+        switch (_mode) {
+            case Mode::kStart:
+                if (c == 'v') {
+                    _mode = Mode::kFutureVersion;
+                    return true;
+                }
+                _mode = Mode::kIPv6;
+                return feedIPv6(c);
+            case Mode::kIPv6:
+                return feedIPv6(c);
+            case Mode::kIPv4Tail:
+                if (!_ipv4.feed(c)) {
+                    _mode = Mode::kError;
+                    return false;
+                }
+                return true;
+            case Mode::kFutureVersion:
+            case Mode::kFutureVersionDigits:
+                if (HasCharClass(c, kHexDigit)) {
+                    _mode = Mode::kFutureVersionDigits;
+                    return true;
+                }
+                if (c == '.' && _mode == Mode::kFutureVersionDigits) {
+                    _mode = Mode::kFutureDot;
+                    return true;
+                }
+                _mode = Mode::kError;
+                return false;
+            case Mode::kFutureDot:
+            case Mode::kFutureText:
+                if (HasCharClass(c, kUserInfo)) {
+                    _mode = Mode::kFutureText;
+                    return true;
+                }
+                _mode = Mode::kError;
+                return false;
+            case Mode::kError:
+                return false;
+        }
+
+        return false;
+    }
+
+    constexpr bool finish() const {
+        switch (_mode) {
+            case Mode::kIPv6:
+                if (_group_digits > 0) {
+                    return isValidGroupsCount(_groups + 1);
+                }
+                // Only "::" can end the address without a group.
+                return _colons == 2 && isValidGroupsCount(_groups);
+            case Mode::kIPv4Tail:
+                return _ipv4.finish() && isValidGroupsCount(_groups + 2);
+            case Mode::kFutureText:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+private:
+    enum class Mode: uint8_t {
+        kStart,
+        kIPv6,
+        kIPv4Tail,
+        kFutureVersion,
+        kFutureVersionDigits,
+        kFutureDot,
+        kFutureText,
+        kError
+    };
+
+    Mode _mode;
+    // Completed h16 groups.
+    uint8_t _groups;
+    // HEXDIG in the current group.
+    uint8_t _group_digits;
+    // Colons right before the current position.
+    uint8_t _colons;
+    bool _double_colon;
+    // The current group read as a dec-octet,
+    // in case it turns out to start an IPv4address.
+    DecOctetAccumulator _group_octet;
+    IPv4Recognizer _ipv4;
+
+    constexpr bool isValidGroupsCount(uint8_t groups) const {
+        return _double_colon ? groups <= 7 : groups == 8;
+    }
+
+    constexpr bool feedIPv6(char c) {
+        if (HasCharClass(c, kHexDigit)) {
+            // A leading colon is only a part of the leading "::".
+            if (_group_digits == 4 || (_colons == 1 && _groups == 0)) {
+                _mode = Mode::kError;
+                return false;
+            }
+
+            _group_digits += 1;
+            _group_octet.add(c);
+            _colons = 0;
+            return true;
+        }
+
+        if (c == ':') {
+            if (_group_digits > 0) {
+                _groups += 1;
+                _group_digits = 0;
+                _group_octet.reset();
+                _colons = 1;
+                // Too many groups to be completed.
+                if (_groups > 7) {
+                    _mode = Mode::kError;
+                    return false;
+                }
+                return true;
+            }
+
+            if (_colons == 0 && _groups == 0 && !_double_colon) {
+                // Leading colon, should be followed by another one.
+                _colons = 1;
+                return true;
+            }
+
+            if (_colons == 1 && !_double_colon) {
+                _colons = 2;
+                _double_colon = true;
+                return true;
+            }
+
+            _mode = Mode::kError;
+            return false;
+        }
+
+        if (c == '.' && _group_digits > 0 && _group_octet.isValid()) {
+            // The current group was the first octet of the trailing IPv4address.
+            _ipv4.resetWithOctet(_group_octet);
+            _ipv4.feed(c);
+            _mode = Mode::kIPv4Tail;
+            return true;
+        }
+
+        _mode = Mode::kError;
+        return false;
+    }
+};
+
+// Decodes IPv6address into 16 bytes in network order.
+//
+// Validation is delegated to IPLiteralRecognizer, which sees every byte
+// first, the decoder only accumulates the values along the way. Groups
+// after "::" are moved to the end of the address once the input is over.
+class IPv6Decoder {
+public:
+    constexpr IPv6Decoder() noexcept:
+        _recognizer(),
+        _groups(),
+        _groups_count(0),
+        _gap(kNoGap),
+        _hex_value(0),
+        _decimal_value(0),
+        _octets(),
+        _octets_count(0),
+        _ipv4_tail(false),
+        _digits(false),
+        _previous_colon(false) {
+        // Empty on purpose.
+    }
+
+    // Returns false once the input cannot be an IPv6address anymore.
+    constexpr bool feed(char c) {
+        // IPvFuture is a valid IP-literal, but not an address.
+        if (c == 'v' || !_recognizer.feed(c)) {
+            return false;
+        }
+
+        if (HasCharClass(c, kHexDigit)) {
+            _hex_value = static_cast<uint16_t>((_hex_value << 4) | HexValue(c));
+            // Only meaningful while the group or the octet is decimal.
+            _decimal_value = static_cast<uint16_t>(_decimal_value * 10 + (c - '0'));
+            _digits = true;
+            return true;
+        }
+
+        if (c == ':') {
+            if (_digits) {
+                _groups[_groups_count++] = _hex_value;
+                resetValues();
+            } else if (_gap == kNoGap && _previous_colon) {
+                _gap = _groups_count;
+            }
+            _previous_colon = true;
+            return true;
+        }
+
+        // The recognizer only lets "." through after a dec-octet.
+        _octets[_octets_count++] = static_cast<uint8_t>(_decimal_value);
+        _ipv4_tail = true;
+        resetValues();
+        return true;
+    }
+
+    // Should be called after the last byte, returns false
+    // when the input is not a complete IPv6address.
+    constexpr bool finish(std::array<uint8_t, 16>& address) {
+        if (!_recognizer.finish()) {
+            return false;
+        }
+
+        if (_ipv4_tail) {
+            _octets[_octets_count++] = static_cast<uint8_t>(_decimal_value);
+            _groups[_groups_count++] = static_cast<uint16_t>((_octets[0] << 8) | _octets[1]);
+            _groups[_groups_count++] = static_cast<uint16_t>((_octets[2] << 8) | _octets[3]);
+        } else if (_digits) {
+            _groups[_groups_count++] = _hex_value;
+        }
+
+        std::array<uint16_t, 8> groups {};
+        const uint8_t gap = (_gap == kNoGap) ? _groups_count : _gap;
+        const uint8_t tail_begin = static_cast<uint8_t>(8 - (_groups_count - gap));
+        for (uint8_t i = 0; i < gap; i++) {
+            groups[i] = _groups[i];
+        }
+        for (uint8_t i = gap; i < _groups_count; i++) {
+            groups[tail_begin + (i - gap)] = _groups[i];
+        }
+
+        for (size_t i = 0; i < groups.size(); i++) {
+            address[2 * i] = static_cast<uint8_t>(groups[i] >> 8);
+            address[2 * i + 1] = static_cast<uint8_t>(groups[i] & 0xFF);
+        }
+        return true;
+    }
+
+private:
+    static constexpr uint8_t kNoGap = 0xFF;
+
+    IPLiteralRecognizer _recognizer;
+    std::array<uint16_t, 8> _groups;
+    uint8_t _groups_count;
+    // Index of the first group after "::".
+    uint8_t _gap;
+    uint16_t _hex_value;
+    uint16_t _decimal_value;
+    std::array<uint8_t, 4> _octets;
+    uint8_t _octets_count;
+    bool _ipv4_tail;
+    // HEXDIG in the current group or octet.
+    bool _digits;
+    bool _previous_colon;
+
+    static constexpr uint8_t HexValue(char c) {
+        if (c >= '0' && c <= '9') {
+            return static_cast<uint8_t>(c - '0');
+        }
+        if (c >= 'a' && c <= 'f') {
+            return static_cast<uint8_t>(c - 'a' + 10);
+        }
+        return static_cast<uint8_t>(c - 'A' + 10);
+    }
+
+    constexpr void resetValues() {
+        _hex_value = 0;
+        _decimal_value = 0;
+        _digits = false;
+        _previous_colon = false;
+    }
+};
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_IP_RECOGNIZERS_H__
@@ -0,0 +1,124 @@
+#ifndef __URIC_SCHEME_RECOGNIZER_H__
+#define __URIC_SCHEME_RECOGNIZER_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "scheme_id.h"
+
+namespace uri {
+
+namespace __internal {
+
+// Lowercased bytes of a scheme packed into a word, the first byte lowest.
+constexpr size_t kMaxPackedSchemeLength = 8;
+// Found by trying odd multipliers until
+// the well-known schemes take different slots.
+constexpr uint64_t kSchemeHashMultiplier = 0x36fbefaa6fb125e3ULL;
+constexpr size_t kSchemeSlotBits = 4;
+
+struct WellKnownScheme {
+    uint64_t word;
+    SchemeId id;
+};
+
+using well_known_schemes_t = std::array<WellKnownScheme, (1U << kSchemeSlotBits)>;
+
+constexpr uint64_t PackScheme(std::string_view name) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < name.length(); i++) {
+        word |= static_cast<uint64_t>(static_cast<uint8_t>(name[i])) << (8 * i);
+    }
+    return word;
+}
+
+// Perfect hash of the packed well-known schemes.
+constexpr size_t SchemeSlot(uint64_t word) {
+    return static_cast<size_t>((word * kSchemeHashMultiplier) >> (64 - kSchemeSlotBits));
+}
+
+constexpr std::array<SchemeId, 9> kWellKnownSchemeIds = {
+    SchemeId::kHttp, SchemeId::kHttps, SchemeId::kWs, SchemeId::kWss, SchemeId::kFtp,
+    SchemeId::kFile, SchemeId::kMailto, SchemeId::kData, SchemeId::kUrn
+};
+
+constexpr well_known_schemes_t MakeWellKnownSchemes() {
+    well_known_schemes_t schemes = {};
+    for (SchemeId id: kWellKnownSchemeIds) {
+        const uint64_t word = PackScheme(SchemeNameOf(id));
+        schemes[SchemeSlot(word)] = WellKnownScheme { word, id };
+    }
+    return schemes;
+}
+
+constexpr well_known_schemes_t kWellKnownSchemes = MakeWellKnownSchemes();
+
+// Recognises the well-known schemes of SchemeId byte by byte,
+// so it works on schemes split between chunks of a stream.
+// The packed scheme is looked up with the perfect hash and
+// recognised with a single comparison of words.
+class SchemeRecognizer {
+public:
+    constexpr SchemeRecognizer() noexcept:
+        _word(0),
+        _length(0) {
+        // Empty on purpose.
+    }
+
+    constexpr void reset() {
+        *this = SchemeRecognizer();
+    }
+
+    // Takes the next byte of the scheme.
+    constexpr void feed(char c) {
+        if (_length < kMaxPackedSchemeLength) {
+            const char lower = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+            _word |= static_cast<uint64_t>(static_cast<uint8_t>(lower)) << (8 * _length);
+        }
+        if (_length <= kMaxPackedSchemeLength) {
+            _length += 1;
+        }
+    }
+
+    constexpr SchemeId finish() const {
+        if (_length > kMaxPackedSchemeLength) {
+            return SchemeId::kOther;
+        }
+
+        const WellKnownScheme& candidate = kWellKnownSchemes[SchemeSlot(_word)];
+        return (candidate.word == _word && candidate.word != 0) ? candidate.id : SchemeId::kOther;
+    }
+
+private:
+    uint64_t _word;
+    size_t _length;
+};
+
+constexpr SchemeId RecognizeScheme(std::string_view scheme) {
+    SchemeRecognizer recognizer;
+    for (char c: scheme) {
+        recognizer.feed(c);
+    }
+    return recognizer.finish();
+}
+
+constexpr bool AreWellKnownSchemesRecognised() {
+    for (SchemeId id: kWellKnownSchemeIds) {
+        if (RecognizeScheme(SchemeNameOf(id)) != id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Two schemes in the same slot would silently lose one of them.
+static_assert(AreWellKnownSchemesRecognised(),
+              "kSchemeHashMultiplier should give every well-known scheme its own slot");
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_SCHEME_RECOGNIZER_H__
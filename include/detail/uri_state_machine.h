@@ -0,0 +1,784 @@
+#ifndef __URIC_URI_STATE_MACHINE_H__
+#define __URIC_URI_STATE_MACHINE_H__
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "char_classes.h"
+#include "char_scanner.h"
+#include "host_type.h"
+#include "ip_recognizers.h"
+#include "parse_result.h"
+#include "scheme_recognizer.h"
+
+namespace uri {
+
+namespace __internal {
+
+// States of UriStateMachine.
+enum class UriMachineState: uint8_t {
+    // Nothing has been read yet.
+    kStart = 0,
+    // ALPHA *( ALPHA / DIGIT / "+" / "-" / "." ), scheme or first segment.
+    kSchemeOrSegment,
+    // Nothing has been read yet, the input should start with a scheme.
+    kSchemeStart,
+    // ALPHA *( ALPHA / DIGIT / "+" / "-" / "." ), cannot be anything but scheme.
+    kScheme,
+    // segment-nz-nc of path-noscheme.
+    kFirstSegment,
+    // Right after "scheme:".
+    kHierStart,
+    // "/" at the beginning of a path, authority follows if another "/" comes.
+    kPathStartSlash,
+    // Right after "//".
+    // States from kAuthorityStart to kPort read the authority.
+    kAuthorityStart,
+    // Either userinfo or host, no ":" yet.
+    kAuthorityText,
+    // Either userinfo or host ":" port, only digits after the first ":".
+    kAuthorityPortOrUserInfo,
+    // Cannot be anything but userinfo, expects "@".
+    kAuthorityUserInfo,
+    // Right after "@".
+    kHostStart,
+    kHostRegName,
+    // Between "[" and "]".
+    kIPLiteral,
+    // Right after "]".
+    kAfterIPLiteral,
+    kPort,
+    kPath,
+    kQuery,
+    kFragment,
+    kError,
+    kCount
+};
+
+// Bytes that UriStateMachine does not distinguish share a category.
+enum class UriByteCategory: uint8_t {
+    kAlpha = 0,
+    kDigit,
+    // "+" / "-" / ".", allowed in scheme.
+    kSchemeSymbol,
+    // Remaining unreserved and sub-delims.
+    kOtherSymbol,
+    kColon,
+    kSlash,
+    kQuestion,
+    kHash,
+    kAt,
+    kPercent,
+    kOpenBracket,
+    kCloseBracket,
+    kInvalid,
+    kCount
+};
+
+inline constexpr size_t kUriMachineStatesCount = static_cast<size_t>(UriMachineState::kCount);
+inline constexpr size_t kUriByteCategoriesCount = static_cast<size_t>(UriByteCategory::kCount);
+
+using uri_byte_categories_t = std::array<UriByteCategory, 256>;
+using uri_transitions_t = std::array<std::array<UriMachineState, kUriByteCategoriesCount>, kUriMachineStatesCount>;
+
+constexpr uri_byte_categories_t MakeUriByteCategoriesTable() {
+    uri_byte_categories_t table{};
+
+    for (size_t i = 0; i < table.size(); i++) {
+        char c = static_cast<char>(i);
+        if (HasCharClass(c, kAlpha)) {
+            table[i] = UriByteCategory::kAlpha;
+        } else if (HasCharClass(c, kDigit)) {
+            table[i] = UriByteCategory::kDigit;
+        } else if (c == '+' || c == '-' || c == '.') {
+            table[i] = UriByteCategory::kSchemeSymbol;
+        } else if (HasCharClass(c, kUnreserved | kSubDelims)) {
+            table[i] = UriByteCategory::kOtherSymbol;
+        } else {
+            table[i] = UriByteCategory::kInvalid;
+        }
+    }
+
+    table[static_cast<uint8_t>(':')] = UriByteCategory::kColon;
+    table[static_cast<uint8_t>('/')] = UriByteCategory::kSlash;
+    table[static_cast<uint8_t>('?')] = UriByteCategory::kQuestion;
+    table[static_cast<uint8_t>('#')] = UriByteCategory::kHash;
+    table[static_cast<uint8_t>('@')] = UriByteCategory::kAt;
+    table[static_cast<uint8_t>('%')] = UriByteCategory::kPercent;
+    table[static_cast<uint8_t>('[')] = UriByteCategory::kOpenBracket;
+    table[static_cast<uint8_t>(']')] = UriByteCategory::kCloseBracket;
+
+    return table;
+}
+
+constexpr void SetUriTransitions(uri_transitions_t& table,
+                                 UriMachineState from,
+                                 std::initializer_list<UriByteCategory> categories,
+                                 UriMachineState to) {
+    for (UriByteCategory category: categories) {
+        table[static_cast<size_t>(from)][static_cast<size_t>(category)] = to;
+    }
+}
+
+constexpr uri_transitions_t MakeUriTransitionsTable() {
+    using S = UriMachineState;
+    using C = UriByteCategory;
+
+    uri_transitions_t table{};
+
+    for (auto& row: table) {
+        for (auto& to: row) {
+            to = S::kError;
+        }
+    }
+
+    // unreserved / sub-delims / pct-encoded.
+    const std::initializer_list<C> text = { C::kAlpha, C::kDigit, C::kSchemeSymbol, C::kOtherSymbol, C::kPercent };
+
+    // Every state that can end a path or an authority.
+    for (S from: { S::kStart, S::kSchemeOrSegment, S::kFirstSegment, S::kHierStart, S::kPathStartSlash,
+                   S::kAuthorityStart, S::kAuthorityText, S::kAuthorityPortOrUserInfo,
+                   S::kHostStart, S::kHostRegName, S::kAfterIPLiteral, S::kPort, S::kPath }) {
+        SetUriTransitions(table, from, { C::kQuestion }, S::kQuery);
+        SetUriTransitions(table, from, { C::kHash }, S::kFragment);
+    }
+
+    SetUriTransitions(table, S::kStart, { C::kAlpha }, S::kSchemeOrSegment);
+    SetUriTransitions(table, S::kStart, { C::kDigit, C::kSchemeSymbol, C::kOtherSymbol, C::kAt, C::kPercent }, S::kFirstSegment);
+    SetUriTransitions(table, S::kStart, { C::kSlash }, S::kPathStartSlash);
+
+    SetUriTransitions(table, S::kSchemeOrSegment, { C::kAlpha, C::kDigit, C::kSchemeSymbol }, S::kSchemeOrSegment);
+    SetUriTransitions(table, S::kSchemeOrSegment, { C::kOtherSymbol, C::kAt, C::kPercent }, S::kFirstSegment);
+    SetUriTransitions(table, S::kSchemeOrSegment, { C::kColon }, S::kHierStart);
+    SetUriTransitions(table, S::kSchemeOrSegment, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kSchemeStart, { C::kAlpha }, S::kScheme);
+
+    SetUriTransitions(table, S::kScheme, { C::kAlpha, C::kDigit, C::kSchemeSymbol }, S::kScheme);
+    SetUriTransitions(table, S::kScheme, { C::kColon }, S::kHierStart);
+
+    SetUriTransitions(table, S::kFirstSegment, text, S::kFirstSegment);
+    SetUriTransitions(table, S::kFirstSegment, { C::kAt }, S::kFirstSegment);
+    SetUriTransitions(table, S::kFirstSegment, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kHierStart, text, S::kPath);
+    SetUriTransitions(table, S::kHierStart, { C::kColon, C::kAt }, S::kPath);
+    SetUriTransitions(table, S::kHierStart, { C::kSlash }, S::kPathStartSlash);
+
+    SetUriTransitions(table, S::kPathStartSlash, text, S::kPath);
+    SetUriTransitions(table, S::kPathStartSlash, { C::kColon, C::kAt }, S::kPath);
+    SetUriTransitions(table, S::kPathStartSlash, { C::kSlash }, S::kAuthorityStart);
+
+    SetUriTransitions(table, S::kAuthorityStart, text, S::kAuthorityText);
+    SetUriTransitions(table, S::kAuthorityStart, { C::kColon }, S::kAuthorityPortOrUserInfo);
+    SetUriTransitions(table, S::kAuthorityStart, { C::kAt }, S::kHostStart);
+    SetUriTransitions(table, S::kAuthorityStart, { C::kOpenBracket }, S::kIPLiteral);
+    SetUriTransitions(table, S::kAuthorityStart, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kAuthorityText, text, S::kAuthorityText);
+    SetUriTransitions(table, S::kAuthorityText, { C::kColon }, S::kAuthorityPortOrUserInfo);
+    SetUriTransitions(table, S::kAuthorityText, { C::kAt }, S::kHostStart);
+    SetUriTransitions(table, S::kAuthorityText, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kAuthorityPortOrUserInfo, text, S::kAuthorityUserInfo);
+    SetUriTransitions(table, S::kAuthorityPortOrUserInfo, { C::kDigit }, S::kAuthorityPortOrUserInfo);
+    SetUriTransitions(table, S::kAuthorityPortOrUserInfo, { C::kColon }, S::kAuthorityUserInfo);
+    SetUriTransitions(table, S::kAuthorityPortOrUserInfo, { C::kAt }, S::kHostStart);
+    SetUriTransitions(table, S::kAuthorityPortOrUserInfo, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kAuthorityUserInfo, text, S::kAuthorityUserInfo);
+    SetUriTransitions(table, S::kAuthorityUserInfo, { C::kColon }, S::kAuthorityUserInfo);
+    SetUriTransitions(table, S::kAuthorityUserInfo, { C::kAt }, S::kHostStart);
+
+    SetUriTransitions(table, S::kHostStart, text, S::kHostRegName);
+    SetUriTransitions(table, S::kHostStart, { C::kOpenBracket }, S::kIPLiteral);
+    SetUriTransitions(table, S::kHostStart, { C::kColon }, S::kPort);
+    SetUriTransitions(table, S::kHostStart, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kHostRegName, text, S::kHostRegName);
+    SetUriTransitions(table, S::kHostRegName, { C::kColon }, S::kPort);
+    SetUriTransitions(table, S::kHostRegName, { C::kSlash }, S::kPath);
+
+    // The content of the literal is checked by IPLiteralRecognizer,
+    // which rejects percent-encoded triplets.
+    SetUriTransitions(table, S::kIPLiteral, text, S::kIPLiteral);
+    SetUriTransitions(table, S::kIPLiteral, { C::kColon }, S::kIPLiteral);
+    SetUriTransitions(table, S::kIPLiteral, { C::kCloseBracket }, S::kAfterIPLiteral);
+
+    SetUriTransitions(table, S::kAfterIPLiteral, { C::kColon }, S::kPort);
+    SetUriTransitions(table, S::kAfterIPLiteral, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kPort, { C::kDigit }, S::kPort);
+    SetUriTransitions(table, S::kPort, { C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kPath, text, S::kPath);
+    SetUriTransitions(table, S::kPath, { C::kColon, C::kAt, C::kSlash }, S::kPath);
+
+    SetUriTransitions(table, S::kQuery, text, S::kQuery);
+    SetUriTransitions(table, S::kQuery, { C::kColon, C::kAt, C::kSlash, C::kQuestion }, S::kQuery);
+    SetUriTransitions(table, S::kQuery, { C::kHash }, S::kFragment);
+
+    SetUriTransitions(table, S::kFragment, text, S::kFragment);
+    SetUriTransitions(table, S::kFragment, { C::kColon, C::kAt, C::kSlash, C::kQuestion }, S::kFragment);
+
+    return table;
+}
+
+inline constexpr uri_byte_categories_t kUriByteCategories = MakeUriByteCategoriesTable();
+inline constexpr uri_transitions_t kUriTransitions = MakeUriTransitionsTable();
+
+// Every byte is mapped to a bitmask of the states it does not leave
+// (bit i stands for the state i), so runs within a component
+// take a single table load per byte. The percent sign is
+// not in any mask as it starts a triplet that needs checking.
+using uri_state_mask_t = uint32_t;
+
+static_assert(kUriMachineStatesCount <= sizeof(uri_state_mask_t) * 8);
+
+constexpr std::array<uri_state_mask_t, 256> MakeUriStaysTable() {
+    std::array<uri_state_mask_t, 256> table{};
+
+    for (size_t byte = 0; byte < table.size(); byte++) {
+        const UriByteCategory category = kUriByteCategories[byte];
+        if (category == UriByteCategory::kPercent) {
+            continue;
+        }
+
+        for (size_t state = 0; state < kUriMachineStatesCount; state++) {
+            if (kUriTransitions[state][static_cast<size_t>(category)] == static_cast<UriMachineState>(state)) {
+                table[byte] |= static_cast<uri_state_mask_t>(1U << state);
+            }
+        }
+    }
+
+    return table;
+}
+
+inline constexpr std::array<uri_state_mask_t, 256> kUriStays = MakeUriStaysTable();
+
+// Single-pass recognizer of URI-reference (or URI when the scheme is required).
+//
+// RFC3986 grammar is ambiguous only when it is read top-down:
+// every decision that the recursive descent parser makes by backtracking
+// can be postponed until a byte that settles it arrives, e.g.
+// a leading "a+b" is either a scheme or a first path segment
+// until ":" or "/" is met, and "user:123" is either userinfo
+// or host and port until "@" or the end of the authority.
+// Therefore the machine reads every byte exactly once, the next state
+// is a lookup in a [state][byte category] table, and components
+// are only marked as offsets from the beginning of the input.
+//
+// The input can be fed in several chunks, offsets are counted
+// from the beginning of the first chunk.
+class UriStateMachine {
+public:
+    // Offsets of a component within the input, [begin, end).
+    struct Range {
+        size_t begin;
+        size_t end;
+        bool present;
+
+        constexpr size_t length() const {
+            return end - begin;
+        }
+    };
+
+    constexpr explicit UriStateMachine(bool require_scheme = false,
+                                       bool bulk_scan = true) noexcept:
+        _state(require_scheme ? UriMachineState::kSchemeStart : UriMachineState::kStart),
+        _bulk_scan(bulk_scan),
+        _finished(false),
+        _pct_remaining(0),
+        _present(0),
+        _host_is_ipv4(false),
+        _host_type(),
+        _position(0),
+        _error_position(0),
+        _error_state(UriMachineState::kError),
+        _error_in_pct_encoded(false),
+        _begins(),
+        _ends(),
+        _ipv4(),
+        _ip_literal(),
+        _ipv6(),
+        _ipv6_failed(false),
+        _ipv6_address(),
+        _port(),
+        _scheme() {
+        // Empty on purpose.
+    }
+
+    // Consumes the next part of the input.
+    // Returns false as soon as the input cannot be a valid URI.
+    constexpr bool feed(std::string_view chunk) {
+        if (_state == UriMachineState::kError || _finished) {
+            return false;
+        }
+
+        const size_t chunk_begin = _position;
+        size_t i = 0;
+
+        while (i < chunk.length()) {
+            // Bytes that keep the machine in the same state need no actions,
+            // except for IPv4address and port decoding.
+            if (_pct_remaining == 0 && _state != UriMachineState::kIPLiteral) {
+                const size_t run_begin = i;
+                i = skipRun(chunk, i, std::min(chunk.length(), i + kBulkScanThreshold));
+
+                // Long runs are handed over to the vectorised scanner,
+                // short ones are cheaper to walk through the table.
+                if (_bulk_scan && i == run_begin + kBulkScanThreshold) {
+                    i += bulkScan(chunk.substr(i));
+                    i = skipRun(chunk, i, chunk.length());
+                }
+
+                if (isHostTextState(_state)) {
+                    for (size_t j = run_begin; j < i && !_ipv4.hasFailed(); j++) {
+                        _ipv4.feed(chunk[j]);
+                    }
+                } else if (isPortState(_state)) {
+                    for (size_t j = run_begin; j < i && !_port.hasFailed(); j++) {
+                        _port.feed(chunk[j]);
+                    }
+                } else if (isSchemeState(_state)) {
+                    for (size_t j = run_begin; j < i; j++) {
+                        _scheme.feed(chunk[j]);
+                    }
+                }
+
+                if (i == chunk.length()) {
+                    break;
+                }
+            }
+
+            if (!step(chunk[i], chunk_begin + i)) {
+                _position = chunk_begin + i;
+                return false;
+            }
+
+            i += 1;
+        }
+
+        _position = chunk_begin + chunk.length();
+        return true;
+    }
+
+    // Marks the end of the input.
+    // Returns true if the entire input is a valid URI.
+    constexpr bool finish() {
+        if (_state == UriMachineState::kError || _finished) {
+            return !hasFailed() && _finished;
+        }
+
+        _finished = true;
+
+        // Scheme, userinfo and IP-literal cannot end the input.
+        if (_pct_remaining > 0 ||
+            _state == UriMachineState::kSchemeStart ||
+            _state == UriMachineState::kScheme ||
+            _state == UriMachineState::kAuthorityUserInfo ||
+            _state == UriMachineState::kIPLiteral) {
+            return fail(_position);
+        }
+
+        close(_position);
+        return true;
+    }
+
+    constexpr bool hasFailed() const {
+        return _state == UriMachineState::kError;
+    }
+
+    // Offset of the first byte that made the input invalid,
+    // equals to the length of the input when the input ended too early.
+    constexpr size_t getErrorPosition() const {
+        return _error_position;
+    }
+
+    // The grammar rule the input has failed to match.
+    constexpr ParseErrorCode getErrorCode() const {
+        if (_error_in_pct_encoded) {
+            return ParseErrorCode::kPctEncoded;
+        }
+
+        switch (_error_state) {
+            case UriMachineState::kStart:
+            case UriMachineState::kSchemeStart:
+            case UriMachineState::kScheme:
+                return ParseErrorCode::kScheme;
+            case UriMachineState::kAuthorityUserInfo:
+                return ParseErrorCode::kUserInfo;
+            case UriMachineState::kAuthorityStart:
+            case UriMachineState::kAuthorityText:
+            case UriMachineState::kHostStart:
+            case UriMachineState::kHostRegName:
+                return ParseErrorCode::kHost;
+            case UriMachineState::kIPLiteral:
+            case UriMachineState::kAfterIPLiteral:
+                return ParseErrorCode::kIPLiteral;
+            case UriMachineState::kAuthorityPortOrUserInfo:
+            case UriMachineState::kPort:
+                return ParseErrorCode::kPort;
+            case UriMachineState::kQuery:
+                return ParseErrorCode::kQuery;
+            case UriMachineState::kFragment:
+                return ParseErrorCode::kFragment;
+            default:
+                return ParseErrorCode::kPath;
+        }
+    }
+
+    constexpr size_t getPosition() const {
+        return _position;
+    }
+
+    constexpr Range getScheme() const {
+        return range(Component::kScheme);
+    }
+
+    constexpr Range getUserInfo() const {
+        return range(Component::kUserInfo);
+    }
+
+    constexpr Range getHost() const {
+        return range(Component::kHost);
+    }
+
+    constexpr const std::optional<HostType>& getHostType() const {
+        return _host_type;
+    }
+
+    // The well-known scheme, recognised as the scheme is read.
+    constexpr SchemeId getSchemeId() const {
+        return ((_present & (1U << kScheme)) != 0) ? _scheme.finish() : SchemeId::kNone;
+    }
+
+    // The address of an IPv4 host, decoded as the host is read.
+    constexpr std::optional<uint32_t> getIPv4() const {
+        return _host_type == HostType::kIPv4 ? std::make_optional(_ipv4.value()) : std::nullopt;
+    }
+
+    // The address of an IPv6 host, IPvFuture and other hosts have none.
+    constexpr std::optional<std::array<uint8_t, 16>> getIPv6() const {
+        return (_host_type == HostType::kIPLiteral && !_ipv6_failed) ? std::make_optional(_ipv6_address) : std::nullopt;
+    }
+
+    constexpr Range getPort() const {
+        return range(Component::kPort);
+    }
+
+    // The port as a number, empty ports and ports
+    // out of the 16-bit range have none.
+    constexpr std::optional<uint16_t> getPortNumber() const {
+        const Range port = getPort();
+        return (port.present && port.length() > 0 && !_port.hasFailed()) ? std::make_optional(_port.value()) : std::nullopt;
+    }
+
+    constexpr Range getPath() const {
+        return range(Component::kPath);
+    }
+
+    constexpr Range getQuery() const {
+        return range(Component::kQuery);
+    }
+
+    constexpr Range getFragment() const {
+        return range(Component::kFragment);
+    }
+
+private:
+    enum Component: uint8_t {
+        kScheme = 0,
+        kUserInfo,
+        kHost,
+        kPort,
+        kPath,
+        kQuery,
+        kFragment,
+        kComponentsCount
+    };
+
+    static constexpr size_t kBulkScanThreshold = 16;
+
+    UriMachineState _state;
+    bool _bulk_scan;
+    bool _finished;
+    // HEXDIG expected to complete a percent-encoded triplet.
+    uint8_t _pct_remaining;
+    // Bit per present component.
+    uint8_t _present;
+    // Whether the authority text before the first colon is an IPv4address.
+    bool _host_is_ipv4;
+    // Assigned through std::make_optional, as assigning a plain value
+    // to std::optional is not constexpr in C++17.
+    std::optional<HostType> _host_type;
+
+    size_t _position;
+    size_t _error_position;
+    // The state the machine has failed in.
+    UriMachineState _error_state;
+    bool _error_in_pct_encoded;
+
+    // Beginnings are marked as soon as a component might start,
+    // e.g. the beginning of userinfo is the beginning of the authority,
+    // and the component becomes present only once it ends.
+    std::array<size_t, kComponentsCount> _begins;
+    std::array<size_t, kComponentsCount> _ends;
+
+    IPv4Recognizer _ipv4;
+    IPLiteralRecognizer _ip_literal;
+    // Decodes the IP-literal validated by _ip_literal, fails on IPvFuture.
+    IPv6Decoder _ipv6;
+    bool _ipv6_failed;
+    std::array<uint8_t, 16> _ipv6_address;
+    PortDecoder _port;
+    SchemeRecognizer _scheme;
+
+    constexpr Range range(Component component) const {
+        return Range{ _begins[component], _ends[component], (_present & (1U << component)) != 0 };
+    }
+
+    constexpr void mark(Component component, size_t begin, size_t end) {
+        _begins[component] = begin;
+        _ends[component] = end;
+        _present |= static_cast<uint8_t>(1U << component);
+    }
+
+    constexpr void markEnd(Component component, size_t end) {
+        mark(component, _begins[component], end);
+    }
+
+    constexpr bool fail(size_t position) {
+        // Only the failure path keeps track of the error details.
+        _error_state = _state;
+        _error_in_pct_encoded = _pct_remaining > 0;
+        _state = UriMachineState::kError;
+        _error_position = position;
+        return false;
+    }
+
+    // Returns the end of the run of bytes within [begin, end)
+    // that keep the machine in the same state.
+    constexpr size_t skipRun(std::string_view chunk, size_t begin, size_t end) const {
+        const uri_state_mask_t state_bit = 1U << static_cast<size_t>(_state);
+
+        size_t i = begin;
+        while (i < end && (kUriStays[static_cast<uint8_t>(chunk[i])] & state_bit) != 0) {
+            i += 1;
+        }
+
+        return i;
+    }
+
+    // Vectorised counterpart of skipRun, percent-encoded triplets
+    // are skipped as well.
+    size_t bulkScan(std::string_view text) const {
+        switch (_state) {
+            case UriMachineState::kFirstSegment:
+                return ScanCharClass(text, kSegmentNcSet);
+            case UriMachineState::kPath:
+                return ScanCharClass(text, kPathSet);
+            case UriMachineState::kQuery:
+            case UriMachineState::kFragment:
+                // "#" is not a part of the set, so the scan stops at the fragment.
+                return ScanCharClass(text, kQueryFragmentSet);
+            case UriMachineState::kAuthorityUserInfo:
+                return ScanCharClass(text, kUserInfoSet);
+            default:
+                return 0;
+        }
+    }
+
+    constexpr bool step(char c, size_t position) {
+        if (_pct_remaining > 0) {
+            if (!HasCharClass(c, kHexDigit)) {
+                return fail(position);
+            }
+
+            _pct_remaining -= 1;
+            return true;
+        }
+
+        const UriByteCategory category = kUriByteCategories[static_cast<uint8_t>(c)];
+        const UriMachineState next = kUriTransitions[static_cast<size_t>(_state)][static_cast<size_t>(category)];
+
+        if (next == UriMachineState::kError) {
+            return fail(position);
+        }
+
+        if (category == UriByteCategory::kPercent) {
+            _pct_remaining = 2;
+        }
+
+        if (next != _state) {
+            if (!enter(next, position)) {
+                return fail(position);
+            }
+            _state = next;
+        }
+
+        if (isHostTextState(_state)) {
+            if (!_ipv4.hasFailed()) {
+                _ipv4.feed(c);
+            }
+        } else if (_state == UriMachineState::kIPLiteral && c != '[') {
+            if (!_ip_literal.feed(c)) {
+                return fail(position);
+            }
+            if (!_ipv6_failed && !_ipv6.feed(c)) {
+                _ipv6_failed = true;
+            }
+        } else if (isPortState(_state) && c != ':') {
+            _port.feed(c);
+        } else if (isSchemeState(_state)) {
+            _scheme.feed(c);
+        }
+
+        return true;
+    }
+
+    // States that read a host which can be an IPv4address.
+    static constexpr bool isHostTextState(UriMachineState state) {
+        return state == UriMachineState::kAuthorityText ||
+               state == UriMachineState::kHostRegName;
+    }
+
+    // States that read what can be a port.
+    static constexpr bool isPortState(UriMachineState state) {
+        return state == UriMachineState::kAuthorityPortOrUserInfo ||
+               state == UriMachineState::kPort;
+    }
+
+    // States that read what can be a scheme.
+    static constexpr bool isSchemeState(UriMachineState state) {
+        return state == UriMachineState::kSchemeOrSegment ||
+               state == UriMachineState::kScheme;
+    }
+
+    static constexpr bool isAuthorityState(UriMachineState state) {
+        return state >= UriMachineState::kAuthorityStart &&
+               state <= UriMachineState::kPort;
+    }
+
+    constexpr HostType textHostType(bool is_ipv4) const {
+        return is_ipv4 ? HostType::kIPv4 : HostType::kRegName;
+    }
+
+    // Actions on entering the |next| state by the byte at |position|.
+    constexpr bool enter(UriMachineState next, size_t position) {
+        switch (next) {
+            case UriMachineState::kHierStart:
+                mark(kScheme, 0, position);
+                _begins[kPath] = position + 1;
+                return true;
+            case UriMachineState::kPathStartSlash:
+                _begins[kPath] = position;
+                return true;
+            case UriMachineState::kAuthorityStart:
+                _begins[kUserInfo] = position + 1;
+                _begins[kHost] = position + 1;
+                _ipv4.reset();
+                return true;
+            case UriMachineState::kAuthorityPortOrUserInfo:
+                // Either the end of the host or a colon within userinfo.
+                _ends[kHost] = position;
+                _begins[kPort] = position + 1;
+                _host_is_ipv4 = _state == UriMachineState::kAuthorityText && _ipv4.finish();
+                _port = PortDecoder();
+                return true;
+            case UriMachineState::kHostStart:
+                markEnd(kUserInfo, position);
+                _begins[kHost] = position + 1;
+                _ipv4.reset();
+                return true;
+            case UriMachineState::kIPLiteral:
+                _begins[kHost] = position + 1;
+                _ip_literal.reset();
+                _ipv6 = IPv6Decoder();
+                _ipv6_failed = false;
+                return true;
+            case UriMachineState::kAfterIPLiteral:
+                if (!_ip_literal.finish()) {
+                    return false;
+                }
+                _ipv6_failed = _ipv6_failed || !_ipv6.finish(_ipv6_address);
+                markEnd(kHost, position);
+                _host_type = std::make_optional(HostType::kIPLiteral);
+                return true;
+            case UriMachineState::kPort:
+                if (_state != UriMachineState::kAfterIPLiteral) {
+                    markEnd(kHost, position);
+                    _host_type = std::make_optional(textHostType(_state == UriMachineState::kHostRegName && _ipv4.finish()));
+                }
+                _begins[kPort] = position + 1;
+                _port = PortDecoder();
+                return true;
+            case UriMachineState::kPath:
+                if (isAuthorityState(_state)) {
+                    closeAuthority(position);
+                    _begins[kPath] = position;
+                }
+                return true;
+            case UriMachineState::kQuery:
+                close(position);
+                _begins[kQuery] = position + 1;
+                return true;
+            case UriMachineState::kFragment:
+                close(position);
+                _begins[kFragment] = position + 1;
+                return true;
+            default:
+                return true;
+        }
+    }
+
+    constexpr void closeAuthority(size_t position) {
+        switch (_state) {
+            case UriMachineState::kAuthorityStart:
+            case UriMachineState::kHostStart:
+                markEnd(kHost, position);
+                _host_type = std::make_optional(HostType::kRegName);
+                break;
+            case UriMachineState::kAuthorityText:
+            case UriMachineState::kHostRegName:
+                markEnd(kHost, position);
+                _host_type = std::make_optional(textHostType(_ipv4.finish()));
+                break;
+            case UriMachineState::kAuthorityPortOrUserInfo:
+                // The end of the host has been marked at the colon.
+                _begins[kHost] = _begins[kUserInfo];
+                markEnd(kHost, _ends[kHost]);
+                _host_type = std::make_optional(textHostType(_host_is_ipv4));
+                markEnd(kPort, position);
+                break;
+            case UriMachineState::kPort:
+                markEnd(kPort, position);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Closes the component that is being read at |position|.
+    constexpr void close(size_t position) {
+        if (_state == UriMachineState::kQuery) {
+            markEnd(kQuery, position);
+        } else if (_state == UriMachineState::kFragment) {
+            markEnd(kFragment, position);
+        } else if (isAuthorityState(_state)) {
+            closeAuthority(position);
+            mark(kPath, position, position);
+        } else {
+            markEnd(kPath, position);
+        }
+    }
+};
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_URI_STATE_MACHINE_H__
@@ -0,0 +1,39 @@
+#ifndef __URIC_FINGERPRINT_H__
+#define __URIC_FINGERPRINT_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace uri {
+
+// 128-bit non-cryptographic hash, wide enough to tell apart
+// the URIs of a large store without comparing the URIs themselves.
+// Fingerprints do not depend on the platform, so they can be stored.
+struct Fingerprint {
+    uint64_t high;
+    uint64_t low;
+
+    constexpr bool operator==(const Fingerprint& that) const {
+        return (high == that.high) && (low == that.low);
+    }
+
+    constexpr bool operator!=(const Fingerprint& that) const {
+        return !operator==(that);
+    }
+};
+
+} // namespace uri
+
+namespace std {
+
+template<>
+struct hash<uri::Fingerprint> {
+    size_t operator()(const uri::Fingerprint& fingerprint) const noexcept {
+        return static_cast<size_t>(fingerprint.low);
+    }
+};
+
+} // namespace std
+
+#endif // __URIC_FINGERPRINT_H__
@@ -0,0 +1,49 @@
+#ifndef __URIC_HOST_TYPE_H__
+#define __URIC_HOST_TYPE_H__
+
+#include <cstdint>
+#include <optional>
+
+namespace uri {
+
+// host = IP-literal / IPv4address / reg-name
+enum class HostType: uint8_t {
+    // No authority.
+    kNone = 0,
+    kIPLiteral,
+    kIPv4,
+    kRegName
+};
+
+namespace __internal {
+
+// Host type found by the parsers, absent when there is no host.
+enum class HostType {
+    kIPLiteral = 0,
+    kIPv4 = 1,
+    kRegName = 2
+};
+
+// Public counterpart of HostType, uri::HostType::kNone when there is no host.
+constexpr uri::HostType ToPublicHostType(const std::optional<HostType>& type) {
+    if (!type) {
+        return uri::HostType::kNone;
+    }
+
+    switch (type.value()) {
+        case HostType::kIPLiteral:
+            return uri::HostType::kIPLiteral;
+        case HostType::kIPv4:
+            return uri::HostType::kIPv4;
+        case HostType::kRegName:
+            return uri::HostType::kRegName;
+    }
+
+    return uri::HostType::kNone;
+}
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_HOST_TYPE_H__
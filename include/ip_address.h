@@ -0,0 +1,36 @@
+#ifndef __URIC_IP_ADDRESS_H__
+#define __URIC_IP_ADDRESS_H__
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace uri {
+
+// IPv4 address in host byte order, e.g. 0x7F000001 for "127.0.0.1".
+using IPv4Address = uint32_t;
+
+// Decodes IPv4address of RFC3986 in a single pass over the input.
+std::optional<IPv4Address> ParseIPv4Address(std::string_view input);
+
+// Decodes port of RFC3986, empty ports and ports
+// greater than 65535 have no number.
+std::optional<uint16_t> ParsePortNumber(std::string_view input);
+
+// IPv6 address in network byte order.
+using IPv6Address = std::array<uint8_t, 16>;
+
+// Decodes IPv6address of RFC3986, without the brackets,
+// in a single pass over the input.
+std::optional<IPv6Address> ParseIPv6Address(std::string_view input);
+
+// Canonical text representation of RFC5952: lower case hexadecimal
+// groups without leading zeroes, the longest run of two or more zero
+// groups replaced with "::", and IPv4-mapped addresses in dotted form.
+std::string ToString(const IPv6Address& address);
+
+} // namespace uri
+
+#endif // __URIC_IP_ADDRESS_H__
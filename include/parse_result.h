@@ -0,0 +1,137 @@
+#ifndef __URIC_PARSE_RESULT_H__
+#define __URIC_PARSE_RESULT_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <variant>
+
+namespace uri {
+
+// The grammar rule an input has failed to match.
+enum class ParseErrorCode: uint8_t {
+    // scheme, including an input that starts with ":".
+    kScheme = 0,
+    // userinfo, text followed by neither "@" nor a valid port.
+    kUserInfo,
+    // reg-name or IPv4address.
+    kHost,
+    // IPv6address or IPvFuture between "[" and "]".
+    kIPLiteral,
+    kPort,
+    kPath,
+    kQuery,
+    kFragment,
+    // "%" not followed by two HEXDIG.
+    kPctEncoded,
+    // The input is longer than the 4 GiB an owning Uri can hold.
+    kTooLong
+};
+
+inline const char* ToString(ParseErrorCode code) {
+    switch (code) {
+        case ParseErrorCode::kScheme:
+            return "scheme";
+        case ParseErrorCode::kUserInfo:
+            return "userinfo";
+        case ParseErrorCode::kHost:
+            return "host";
+        case ParseErrorCode::kIPLiteral:
+            return "IP-literal";
+        case ParseErrorCode::kPort:
+            return "port";
+        case ParseErrorCode::kPath:
+            return "path";
+        case ParseErrorCode::kQuery:
+            return "query";
+        case ParseErrorCode::kFragment:
+            return "fragment";
+        case ParseErrorCode::kPctEncoded:
+            return "pct-encoded";
+        case ParseErrorCode::kTooLong:
+            return "too long";
+    }
+
+    return "unknown";
+}
+
+struct ParseError {
+    ParseErrorCode code;
+    // Offset of the offending byte, equals to the length
+    // of the input when the input ends too early.
+    size_t position;
+
+    bool operator==(const ParseError& that) const {
+        return code == that.code && position == that.position;
+    }
+
+    bool operator!=(const ParseError& that) const {
+        return !operator==(that);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const ParseError& that) {
+        return stream << ToString(that.code) << " at " << that.position;
+    }
+};
+
+// Either a parsed value or the reason the input has been rejected.
+template<typename T>
+class ParseResult {
+public:
+    ParseResult(const T& value) noexcept:
+        _result(std::in_place_index<0>, value) {
+        // Empty on purpose.
+    }
+
+    ParseResult(T&& value) noexcept:
+        _result(std::in_place_index<0>, std::move(value)) {
+        // Empty on purpose.
+    }
+
+    ParseResult(const ParseError& error) noexcept:
+        _result(std::in_place_index<1>, error) {
+        // Empty on purpose.
+    }
+
+    ParseResult(const ParseResult& that) = default;
+    ParseResult& operator=(const ParseResult& that) = default;
+    ParseResult(ParseResult&& that) = default;
+    ParseResult& operator=(ParseResult&& that) = default;
+
+    inline bool hasValue() const {
+        return _result.index() == 0;
+    }
+
+    inline explicit operator bool() const {
+        return hasValue();
+    }
+
+    // Should only be called when hasValue() is true.
+    inline const T& value() const {
+        return *std::get_if<0>(&_result);
+    }
+
+    inline T& value() {
+        return *std::get_if<0>(&_result);
+    }
+
+    // Should only be called when hasValue() is false.
+    inline const ParseError& getError() const {
+        return *std::get_if<1>(&_result);
+    }
+
+    std::optional<T> toOptional() const {
+        return hasValue() ? std::make_optional(value()) : std::nullopt;
+    }
+
+    ~ParseResult() = default;
+
+private:
+    std::variant<T, ParseError> _result;
+};
+
+} // namespace uri
+
+#endif // __URIC_PARSE_RESULT_H__
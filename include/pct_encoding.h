@@ -0,0 +1,49 @@
+#ifndef __URIC_PCT_ENCODING_H__
+#define __URIC_PCT_ENCODING_H__
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace uri {
+
+// Characters a component keeps as they are when encoded,
+// every other byte, including "%", is percent-encoded.
+enum class EncodeSet: uint8_t {
+    // userinfo: unreserved / sub-delims / ":"
+    kUserInfo = 0,
+    // reg-name: unreserved / sub-delims
+    kHost,
+    // path: pchar / "/"
+    kPath,
+    // segment: pchar, "/" is encoded.
+    kSegment,
+    // query: pchar / "/" / "?"
+    kQuery,
+    // A key or a value of a query item: query without "&", "=" and "+".
+    kQueryParam,
+    // fragment: pchar / "/" / "?"
+    kFragment
+};
+
+// Percent-encodes |input| to be used as a component, e.g.
+// encode<EncodeSet::kQueryParam>("a&b") returns "a%26b".
+// The set is chosen at compile time, the output is allocated once.
+template<EncodeSet kSet>
+std::string encode(std::string_view input);
+
+extern template std::string encode<EncodeSet::kUserInfo>(std::string_view input);
+extern template std::string encode<EncodeSet::kHost>(std::string_view input);
+extern template std::string encode<EncodeSet::kPath>(std::string_view input);
+extern template std::string encode<EncodeSet::kSegment>(std::string_view input);
+extern template std::string encode<EncodeSet::kQuery>(std::string_view input);
+extern template std::string encode<EncodeSet::kQueryParam>(std::string_view input);
+extern template std::string encode<EncodeSet::kFragment>(std::string_view input);
+
+// Decodes every percent-encoded triplet of |input|,
+// a "%" that does not start a triplet is kept as it is.
+std::string decode(std::string_view input);
+
+} // namespace uri
+
+#endif // __URIC_PCT_ENCODING_H__
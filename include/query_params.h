@@ -0,0 +1,201 @@
+#ifndef __URIC_QUERY_PARAMS_H__
+#define __URIC_QUERY_PARAMS_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "query_view.h"
+
+namespace uri {
+
+// Order-preserving multimap of the query parameters.
+//
+// The query is copied once, the items are kept in a flat vector
+// as offsets into the copy, in the order they appear in the query.
+// Repeated keys are all kept, find returns the first value.
+// Items are split the same way QueryView splits them.
+class QueryParams {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    using value_type = std::pair<std::string_view, std::string_view>;
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = QueryParams::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        Iterator(const QueryParams* params, size_t index) noexcept:
+            _params(params),
+            _index(index) {
+            // Empty on purpose.
+        }
+
+        inline value_type operator*() const {
+            return (*_params)[_index];
+        }
+
+        inline Iterator& operator++() {
+            _index += 1;
+            return *this;
+        }
+
+        inline Iterator operator++(int) {
+            Iterator that = *this;
+            _index += 1;
+            return that;
+        }
+
+        inline bool operator==(const Iterator& that) const {
+            return _params == that._params && _index == that._index;
+        }
+
+        inline bool operator!=(const Iterator& that) const {
+            return !operator==(that);
+        }
+
+    private:
+        const QueryParams* _params;
+        size_t _index;
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    explicit QueryParams(const allocator_type& allocator = allocator_type()) noexcept:
+        _query(allocator),
+        _items(allocator) {
+        // Empty on purpose.
+    }
+
+    explicit QueryParams(std::string_view query,
+                         const allocator_type& allocator = allocator_type()):
+        _query(query, allocator),
+        _items(allocator) {
+        for (const auto& [key, value]: QueryView(_query)) {
+            const auto begin = static_cast<uint32_t>(key.data() - _query.data());
+            const auto separator = static_cast<uint32_t>(begin + key.length());
+            // Keys never contain "=", items without it have an empty value.
+            const bool has_value = separator < _query.length() && _query[separator] == kQueryKeyValueSeparator;
+            const auto end = has_value ? static_cast<uint32_t>(separator + 1 + value.length()) : separator;
+            _items.push_back(Item { begin, separator, end });
+        }
+    }
+
+    QueryParams(const QueryParams& that) = default;
+    QueryParams& operator=(const QueryParams& that) = default;
+    QueryParams(QueryParams&& that) = default;
+    QueryParams& operator=(QueryParams&& that) = default;
+
+    QueryParams(const QueryParams& that, const allocator_type& allocator):
+        _query(that._query, allocator),
+        _items(that._items, allocator) {
+        // Empty on purpose.
+    }
+
+    QueryParams(QueryParams&& that, const allocator_type& allocator):
+        _query(std::move(that._query), allocator),
+        _items(std::move(that._items), allocator) {
+        // Empty on purpose.
+    }
+
+    // Same items in the same order.
+    bool operator==(const QueryParams& that) const {
+        if (size() != that.size()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < size(); i++) {
+            if ((*this)[i] != that[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const QueryParams& that) const {
+        return !operator==(that);
+    }
+
+    inline size_t size() const {
+        return _items.size();
+    }
+
+    inline bool empty() const {
+        return _items.empty();
+    }
+
+    inline value_type operator[](size_t index) const {
+        const auto& item = _items[index];
+        const std::string_view query = _query;
+        const uint32_t value_begin = (item.separator < item.end) ? item.separator + 1 : item.end;
+        return value_type(query.substr(item.begin, item.separator - item.begin),
+                          query.substr(value_begin, item.end - value_begin));
+    }
+
+    inline Iterator begin() const {
+        return Iterator(this, 0);
+    }
+
+    inline Iterator end() const {
+        return Iterator(this, _items.size());
+    }
+
+    // The value of the first item with the key, if any.
+    std::optional<std::string_view> find(std::string_view key) const {
+        for (size_t i = 0; i < _items.size(); i++) {
+            const auto& item = (*this)[i];
+            if (item.first == key) {
+                return item.second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Values of all the items with the key, in order.
+    std::vector<std::string_view> findAll(std::string_view key) const {
+        std::vector<std::string_view> values;
+        for (size_t i = 0; i < _items.size(); i++) {
+            const auto& item = (*this)[i];
+            if (item.first == key) {
+                values.push_back(item.second);
+            }
+        }
+        return values;
+    }
+
+    inline bool contains(std::string_view key) const {
+        return find(key).has_value();
+    }
+
+    inline allocator_type get_allocator() const {
+        return _query.get_allocator();
+    }
+
+    ~QueryParams() = default;
+
+private:
+    // Offsets into the query, the value is between
+    // the separator and the end, excluding the "=".
+    struct Item {
+        uint32_t begin;
+        uint32_t separator;
+        uint32_t end;
+    };
+
+    std::pmr::string _query;
+    std::pmr::vector<Item> _items;
+};
+
+} // namespace uri
+
+#endif // __URIC_QUERY_PARAMS_H__
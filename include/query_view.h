@@ -0,0 +1,176 @@
+#ifndef __URIC_QUERY_VIEW_H__
+#define __URIC_QUERY_VIEW_H__
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace uri {
+
+constexpr char kQueryItemsSeparator = '&';
+constexpr char kQueryKeyValueSeparator = '=';
+
+// Non-owning sequence of the "key=value" items of a query.
+//
+// Items are found on the fly while iterating, nothing is allocated
+// or parsed up front. Only the first "=" separates the key from the value,
+// items without a key and without "=" are skipped, e.g. "a=1&&=&b"
+// yields ("a", "1"), ("", "") and ("b", "").
+// Keys and values point into the query, therefore
+// the query should outlive the view. Iterators yield items by value,
+// the same way QueryParams iterators do.
+class QueryView {
+public:
+    using value_type = std::pair<std::string_view, std::string_view>;
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = QueryView::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        constexpr Iterator() noexcept:
+            _remaining(),
+            _item(),
+            _end(true) {
+            // Empty on purpose.
+        }
+
+        constexpr value_type operator*() const {
+            return _item;
+        }
+
+        constexpr Iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        constexpr Iterator operator++(int) {
+            Iterator that = *this;
+            advance();
+            return that;
+        }
+
+        constexpr bool operator==(const Iterator& that) const {
+            if (_end || that._end) {
+                return _end == that._end;
+            }
+            return _remaining.data() == that._remaining.data() &&
+                   _remaining.length() == that._remaining.length();
+        }
+
+        constexpr bool operator!=(const Iterator& that) const {
+            return !operator==(that);
+        }
+
+    private:
+        friend class QueryView;
+
+        // Not yet visited part of the query, including the current item.
+        std::string_view _remaining;
+        value_type _item;
+        bool _end;
+
+        constexpr explicit Iterator(std::string_view query) noexcept:
+            _remaining(query),
+            _item(),
+            _end(false) {
+            find();
+        }
+
+        constexpr void advance() {
+            const size_t item_end = _remaining.find(kQueryItemsSeparator);
+            if (item_end == std::string_view::npos) {
+                _end = true;
+                _remaining = std::string_view();
+                return;
+            }
+
+            _remaining.remove_prefix(item_end + 1);
+            find();
+        }
+
+        // Stops at the first item worth yielding, starting from the current one.
+        constexpr void find() {
+            while (true) {
+                const size_t item_end = _remaining.find(kQueryItemsSeparator);
+                const std::string_view item = _remaining.substr(0, item_end);
+
+                const size_t separator = item.find(kQueryKeyValueSeparator);
+                if (separator != std::string_view::npos) {
+                    // std::pair assignment is not constexpr until C++20.
+                    _item.first = item.substr(0, separator);
+                    _item.second = item.substr(separator + 1);
+                    return;
+                }
+
+                if (!item.empty()) {
+                    _item.first = item;
+                    _item.second = std::string_view();
+                    return;
+                }
+
+                if (item_end == std::string_view::npos) {
+                    _end = true;
+                    _remaining = std::string_view();
+                    return;
+                }
+
+                _remaining.remove_prefix(item_end + 1);
+            }
+        }
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    constexpr QueryView() noexcept:
+        _query() {
+        // Empty on purpose.
+    }
+
+    constexpr explicit QueryView(std::string_view query) noexcept:
+        _query(query) {
+        // Empty on purpose.
+    }
+
+    constexpr QueryView(const QueryView& that) noexcept = default;
+    constexpr QueryView& operator=(const QueryView& that) noexcept = default;
+
+    constexpr Iterator begin() const {
+        return Iterator(_query);
+    }
+
+    constexpr Iterator end() const {
+        return Iterator();
+    }
+
+    constexpr bool empty() const {
+        return begin() == end();
+    }
+
+    // The value of the first item with the key, if any.
+    constexpr std::optional<std::string_view> find(std::string_view key) const {
+        for (const auto& item: *this) {
+            if (item.first == key) {
+                return item.second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    constexpr std::string_view getQuery() const {
+        return _query;
+    }
+
+private:
+    std::string_view _query;
+};
+
+} // namespace uri
+
+#endif // __URIC_QUERY_VIEW_H__
@@ -0,0 +1,85 @@
+#ifndef __URIC_RESOLVED_BASE_H__
+#define __URIC_RESOLVED_BASE_H__
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "uri.h"
+#include "uri_view.h"
+
+namespace uri {
+
+// Base URI prepared for resolving many references against it,
+// see RFC3986 section 5.2.
+//
+// The base is parsed and its path is cleared of dot segments once,
+// so resolving a reference only merges its components with the ones
+// of the base: resolved paths are assembled on the stack and every
+// resolved Uri is allocated once and exactly to size.
+// As permitted by section 5.2.1, the base is used with dot segments
+// removed, e.g. "http://a/b/../c" resolves "d" to "http://a/d".
+// Relativization is the inverse: it finds the reference a target
+// resolves from.
+class ResolvedBase {
+public:
+    // The base is allocated with the allocator,
+    // e.g. in a std::pmr::monotonic_buffer_resource.
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    // Only absolute URIs, i.e. ones with a scheme, can be bases.
+    static std::optional<ResolvedBase> from(const Uri& base,
+                                            const allocator_type& allocator = allocator_type());
+    static std::optional<ResolvedBase> parse(std::string_view base,
+                                             const allocator_type& allocator = allocator_type());
+
+    ResolvedBase(const ResolvedBase& that) = default;
+    ResolvedBase& operator=(const ResolvedBase& that) = default;
+    ResolvedBase(ResolvedBase&& that) = default;
+    ResolvedBase& operator=(ResolvedBase&& that) = default;
+
+    // Resolves the reference, an invalid reference has no target.
+    std::optional<Uri> resolve(std::string_view reference,
+                               const allocator_type& allocator = allocator_type()) const;
+    Uri resolve(const UriView& reference,
+                const allocator_type& allocator = allocator_type()) const;
+    Uri resolve(const Uri& reference,
+                const allocator_type& allocator = allocator_type()) const;
+
+    // The shortest reference that resolves against the base to the absolute
+    // target, e.g. "g?y" for "http://a/b/c/g?y" against "http://a/b/c/d".
+    // Targets of other schemes are kept as they are, targets that are
+    // not absolute have no reference. Like every resolved path, the path
+    // of the target is taken without dot segments.
+    std::optional<Uri> relativize(const UriView& target,
+                                  const allocator_type& allocator = allocator_type()) const;
+    std::optional<Uri> relativize(const Uri& target,
+                                  const allocator_type& allocator = allocator_type()) const;
+
+    inline const Uri& getBase() const {
+        return _base;
+    }
+
+    // The path of the base without dot segments.
+    inline std::string_view getPath() const {
+        return _path;
+    }
+
+    inline allocator_type get_allocator() const {
+        return _path.get_allocator();
+    }
+
+    ~ResolvedBase() = default;
+
+private:
+    Uri _base;
+    std::pmr::string _path;
+
+    ResolvedBase(const Uri& base, const allocator_type& allocator) noexcept;
+};
+
+} // namespace uri
+
+#endif // __URIC_RESOLVED_BASE_H__
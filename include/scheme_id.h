@@ -0,0 +1,56 @@
+#ifndef __URIC_SCHEME_ID_H__
+#define __URIC_SCHEME_ID_H__
+
+#include <cstdint>
+#include <string_view>
+
+namespace uri {
+
+// Well-known schemes, recognised while parsing regardless of case,
+// so a scheme can be dispatched on without comparing strings.
+enum class SchemeId: uint8_t {
+    // No scheme, i.e. a relative reference.
+    kNone = 0,
+    // Any scheme not listed below.
+    kOther,
+    kHttp,
+    kHttps,
+    kWs,
+    kWss,
+    kFtp,
+    kFile,
+    kMailto,
+    kData,
+    kUrn
+};
+
+// The lowercase name of a well-known scheme, e.g. "https" for kHttps,
+// empty for kNone and kOther. Names are static, they are never allocated.
+constexpr std::string_view SchemeNameOf(SchemeId id) {
+    switch (id) {
+        case SchemeId::kHttp:
+            return "http";
+        case SchemeId::kHttps:
+            return "https";
+        case SchemeId::kWs:
+            return "ws";
+        case SchemeId::kWss:
+            return "wss";
+        case SchemeId::kFtp:
+            return "ftp";
+        case SchemeId::kFile:
+            return "file";
+        case SchemeId::kMailto:
+            return "mailto";
+        case SchemeId::kData:
+            return "data";
+        case SchemeId::kUrn:
+            return "urn";
+        default:
+            return std::string_view();
+    }
+}
+
+} // namespace uri
+
+#endif // __URIC_SCHEME_ID_H__
@@ -1,10 +1,23 @@
 #ifndef __URIC_URI_H__
 #define __URIC_URI_H__
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include "authority.h"
+#include "authority_view.h"
+#include "fingerprint.h"
+#include "host_type.h"
+#include "parse_result.h"
+#include "scheme_id.h"
+#include "uri_view.h"
 
 namespace {
 
@@ -14,109 +27,284 @@ using optional_string_t = std::optional<std::string>;
 
 namespace uri {
 
+namespace __internal {
+
+class UriStateMachine;
+
+} // namespace __internal
+
+class UriStreamParser;
+
+// Owning URI reference.
+//
+// The serialised URI reference is stored in a single buffer,
+// getters return views of the buffer, therefore the views
+// are valid only as long as the Uri is alive and not modified.
+// Offsets within the buffer are 32-bit, so a Uri holds at most
+// 4 GiB: parse and fromParts reject longer URIs, the constructors
+// expect the caller to respect the limit.
 class Uri {
 public:
-    static std::optional<Uri> parse(const std::string& input);
-    static std::optional<Uri> fromParts(const std::string& raw_path,
-                                        const optional_string_t& raw_scheme,
-                                        const optional_string_t& raw_authority,
-                                        const optional_string_t& raw_query,
-                                        const optional_string_t& raw_fragment);
+    // The buffer is allocated with the allocator,
+    // e.g. in a std::pmr::monotonic_buffer_resource.
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    static std::optional<Uri> parse(std::string_view input,
+                                    const allocator_type& allocator = allocator_type());
+    // Same as parse, but reports why the input has been rejected.
+    static ParseResult<Uri> tryParse(std::string_view input,
+                                     const allocator_type& allocator = allocator_type());
+    static std::optional<Uri> fromParts(std::string_view raw_path,
+                                        const optional_string_view_t& raw_scheme,
+                                        const optional_string_view_t& raw_authority,
+                                        const optional_string_view_t& raw_query,
+                                        const optional_string_view_t& raw_fragment,
+                                        const allocator_type& allocator = allocator_type());
+    // Resolves the reference against the absolute base, see RFC3986
+    // section 5.2. Use ResolvedBase to resolve many references
+    // against the same base.
+    static std::optional<Uri> resolve(const Uri& base,
+                                      const Uri& reference,
+                                      const allocator_type& allocator = allocator_type());
+    // The shortest reference that resolves against the absolute base
+    // to the absolute target, see ResolvedBase::relativize.
+    static std::optional<Uri> relativize(const Uri& base,
+                                         const Uri& target,
+                                         const allocator_type& allocator = allocator_type());
     static std::string normalisePath(const std::string& path);
+    // Same as normalisePath, but normalises |path| in place.
+    static void normalisePathInPlace(std::string& path);
 
-    explicit Uri(const std::string& path,
-                 const optional_string_t& query = std::nullopt,
-                 const optional_string_t& fragment = std::nullopt) noexcept:
-        _scheme(),
-        _authority(),
-        _path(path),
-        _query(query),
-        _fragment(fragment) {
-        // Empty on purpose.
-    }
+    explicit Uri(std::string_view path,
+                 const optional_string_view_t& query = std::nullopt,
+                 const optional_string_view_t& fragment = std::nullopt,
+                 const allocator_type& allocator = allocator_type()) noexcept;
 
-    Uri(const optional_string_t& scheme,
+    Uri(const optional_string_view_t& scheme,
         const std::optional<Authority>& authority,
-        const std::string& path,
-        const optional_string_t& query = std::nullopt,
-        const optional_string_t& fragment = std::nullopt) noexcept:
-        _scheme(scheme),
-        _authority(authority),
-        _path(path),
-        _query(query),
-        _fragment(fragment) {
-        // Empty on purpose.
-    }
+        std::string_view path,
+        const optional_string_view_t& query = std::nullopt,
+        const optional_string_view_t& fragment = std::nullopt,
+        const allocator_type& allocator = allocator_type()) noexcept;
+
+    explicit Uri(const UriView& view,
+                 const allocator_type& allocator = allocator_type()) noexcept;
 
     Uri(const Uri& that) = default;
     Uri& operator=(const Uri& that) = default;
     Uri(Uri&& that) = default;
     Uri& operator=(Uri&& that) = default;
 
+    Uri(const Uri& that, const allocator_type& allocator) noexcept:
+        _buffer(that._buffer, allocator),
+        _ends(that._ends),
+        _present(that._present),
+        _host_type(that._host_type),
+        _scheme_id(that._scheme_id),
+        _decoded(that._decoded),
+        _port_number(that._port_number),
+        _address(that._address),
+        _hash(that._hash) {
+        // Empty on purpose.
+    }
+
+    Uri(Uri&& that, const allocator_type& allocator) noexcept:
+        _buffer(std::move(that._buffer), allocator),
+        _ends(that._ends),
+        _present(that._present),
+        _host_type(that._host_type),
+        _scheme_id(that._scheme_id),
+        _decoded(that._decoded),
+        _port_number(that._port_number),
+        _address(that._address),
+        _hash(that._hash) {
+        // Empty on purpose.
+    }
+
     bool operator==(const Uri& that) const {
-        return (_scheme == that._scheme)
-        && (_authority == that._authority)
-        && (_path == that._path)
-        && (_query == that._query)
-        && (_fragment == that._fragment);
+        if (_hash != that._hash) {
+            return false;
+        }
+
+        // The same components are always serialised the same way,
+        // the boundaries tell apart, e.g., "a:b" as a scheme and a path
+        // from the same text as a path.
+        return (_buffer == that._buffer)
+        && (_ends == that._ends)
+        && (_present == that._present)
+        && (_host_type == that._host_type);
     }
 
     bool operator!=(const Uri& that) const {
         return !operator==(that);
     }
 
-    friend std::ostream& operator<<(std::ostream& stream, const Uri& that) { 
-        if (that._scheme) {
-            stream << that._scheme.value() << ':';
-        }
+    friend std::ostream& operator<<(std::ostream& stream, const Uri& that) {
+        return stream << that._buffer;
+    }
 
-        if (that._authority) {
-            stream << "//" << that._authority.value();
-        }
+    inline optional_string_view_t getScheme() const {
+        return getComponent(kScheme);
+    }
 
-        stream << that._path;
+    // The well-known scheme, whatever its case, e.g. kHttps for "HTTPS",
+    // recognised once the URI is parsed or built.
+    inline SchemeId getSchemeId() const {
+        return _scheme_id;
+    }
 
-        if (that._query) {
-            stream << '?' << that._query.value();
-        }
+    // The view carries the addresses and the port number
+    // decoded once the URI is parsed or built.
+    std::optional<AuthorityView> getAuthority() const;
 
-        if (that._fragment) {
-            stream << '#' << that._fragment.value();
-        }
+    inline HostType getHostType() const {
+        return _host_type;
+    }
+
+    inline std::string_view getPath() const {
+        return getComponent(kPath).value();
+    }
 
-        return stream;
+    inline optional_string_view_t getQuery() const {
+        return getComponent(kQuery);
     }
 
-    inline const optional_string_t& getScheme() const {
-        return _scheme;
+    inline optional_string_view_t getFragment() const {
+        return getComponent(kFragment);
     }
 
-    inline const std::optional<Authority>& getAuthority() const {
-        return _authority;
+    // The serialised URI reference.
+    inline std::string_view toString() const {
+        return _buffer;
     }
 
-    inline const std::string& getPath() const {
-        return _path;
+    // Hash of the serialised URI reference, computed once
+    // the reference is parsed or built. Not cryptographic.
+    inline uint64_t getHash() const {
+        return _hash;
     }
 
-    inline const optional_string_t& getQuery() const {
-        return _query;
+    // 128-bit counterpart of getHash, e.g. to deduplicate stored URIs.
+    Fingerprint getFingerprint() const;
+
+    // Hashes of the normal form, see normalised: URIs that are equal
+    // once normalised have equal hashes. The normal form is hashed
+    // component by component, without being built.
+    uint64_t getNormalisedHash() const;
+    Fingerprint getNormalisedFingerprint() const;
+
+    // Syntax-based normalisation of RFC3986, see section 6.2.2, and
+    // the scheme-based one of section 6.2.3 for schemes with default
+    // ports: the scheme and the host are lowercased, percent-encoded
+    // triplets are uppercased or decoded if they are unreserved, dot
+    // segments are removed, empty and default ports are removed and
+    // an empty path of an http(s), ws(s) or ftp URI becomes "/".
+    // A URI that is already normal is copied as it is.
+    Uri normalised(const allocator_type& allocator = allocator_type()) const;
+    // Whether normalised() would return the same URI.
+    bool isNormalised() const;
+
+    inline UriView toView() const {
+        return UriView(getScheme(), _scheme_id, getAuthority(), getPath(), getQuery(), getFragment());
     }
 
-    inline const optional_string_t& getFragment() const {
-        return _fragment;
+    inline allocator_type get_allocator() const {
+        return _buffer.get_allocator();
     }
 
     ~Uri() = default;
 
 private:
-    optional_string_t _scheme;
-    std::optional<Authority> _authority;
-    std::string _path;
-    optional_string_t _query;
-    optional_string_t _fragment;
+    // Values decoded once, so connections take them without parsing.
+    enum Decoded: uint8_t {
+        kDecodedIPv4 = 1U << 0,
+        kDecodedIPv6 = 1U << 1,
+        kDecodedPortNumber = 1U << 2
+    };
+
+    enum Component: uint8_t {
+        kScheme = 0,
+        kUserInfo,
+        kHost,
+        kPort,
+        kPath,
+        kQuery,
+        kFragment,
+        kComponentsCount
+    };
+
+    friend class UriStreamParser;
+
+    std::pmr::string _buffer;
+    // Only the ends of the components are stored, the beginnings
+    // follow from the separators, see beginOf. The ends of absent
+    // components are zeroes.
+    std::array<uint32_t, kComponentsCount> _ends;
+    // Bit per present component.
+    uint8_t _present;
+    HostType _host_type;
+    SchemeId _scheme_id;
+    // Bit per decoded value, see Decoded.
+    uint8_t _decoded;
+    uint16_t _port_number;
+    // The address of an IPv6 host, or of an IPv4 host in the first
+    // four bytes, the host is never both.
+    IPv6Address _address;
+    uint64_t _hash;
+
+    explicit Uri(const allocator_type& allocator) noexcept;
+
+    inline bool has(Component component) const {
+        return (_present & (1U << component)) != 0;
+    }
+
+    size_t beginOf(Component component) const;
+
+    inline optional_string_view_t getComponent(Component component) const {
+        if (!has(component)) {
+            return std::nullopt;
+        }
+
+        const size_t begin = beginOf(component);
+        return std::string_view(_buffer.data() + begin, _ends[component] - begin);
+    }
+
+    void updateHash();
+    // Decodes the addresses and the port number from the buffer.
+    void decodeAuthority();
+    void setDecoded(const std::optional<IPv4Address>& ipv4,
+                    const std::optional<IPv6Address>& ipv6,
+                    const std::optional<uint16_t>& port_number);
+    // Takes the components of |_buffer| from the machine that has parsed it.
+    void assignParsed(const __internal::UriStateMachine& machine);
+    void markEnd(Component component);
+    void append(Component component, std::string_view value);
+    void assign(const optional_string_view_t& scheme,
+                const optional_string_view_t& userInfo,
+                const optional_string_view_t& host,
+                HostType hostType,
+                const optional_string_view_t& port,
+                std::string_view path,
+                const optional_string_view_t& query,
+                const optional_string_view_t& fragment);
+
+    // Calls |emit| with the pieces of the normal form in order, together
+    // with the component they belong to, separators go with kComponentsCount.
+    template<typename Emit>
+    void forEachNormalisedPiece(Emit&& emit) const;
 };
 
 } // namespace uri
 
+namespace std {
+
+template<>
+struct hash<uri::Uri> {
+    size_t operator()(const uri::Uri& uri) const noexcept {
+        return static_cast<size_t>(uri.getHash());
+    }
+};
+
+} // namespace std
+
 #endif // __URIC_URI_H__
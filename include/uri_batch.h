@@ -0,0 +1,150 @@
+#ifndef __URIC_URI_BATCH_H__
+#define __URIC_URI_BATCH_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "host_type.h"
+#include "uri_view.h"
+
+namespace uri {
+
+// Results of parsing many URI references at once,
+// laid out as a structure of arrays: every property
+// of all the URI references is stored contiguously.
+//
+// Components are described by offsets and lengths
+// within their inputs, therefore the inputs should
+// outlive the batch.
+class UriBatch {
+public:
+    enum class Component: uint8_t {
+        kScheme = 0,
+        kUserInfo,
+        kHost,
+        kPort,
+        kPath,
+        kQuery,
+        kFragment,
+        kCount
+    };
+
+    using HostType = uri::HostType;
+
+    static constexpr size_t kComponentsCount = static_cast<size_t>(Component::kCount);
+
+    UriBatch() noexcept:
+        _inputs(),
+        _validity(),
+        _presence(),
+        _host_types(),
+        _offsets(),
+        _lengths() {
+        // Empty on purpose.
+    }
+
+    UriBatch(const UriBatch& that) = default;
+    UriBatch& operator=(const UriBatch& that) = default;
+    UriBatch(UriBatch&& that) = default;
+    UriBatch& operator=(UriBatch&& that) = default;
+
+    inline size_t size() const {
+        return _inputs.size();
+    }
+
+    inline bool isValid(size_t index) const {
+        return (_validity[index / 64] >> (index % 64)) & 1U;
+    }
+
+    // Bit |index % 64| of word |index / 64| is set
+    // when the input at |index| is a valid URI reference.
+    inline const std::vector<uint64_t>& getValidityBitmap() const {
+        return _validity;
+    }
+
+    inline bool hasComponent(size_t index, Component component) const {
+        return (_presence[index] >> static_cast<size_t>(component)) & 1U;
+    }
+
+    // Bit per Component, set when the component is present.
+    inline const std::vector<uint8_t>& getPresence() const {
+        return _presence;
+    }
+
+    inline HostType getHostType(size_t index) const {
+        return _host_types[index];
+    }
+
+    inline const std::vector<HostType>& getHostTypes() const {
+        return _host_types;
+    }
+
+    // Offsets of the component within the inputs,
+    // zero when the component is not present.
+    inline const std::vector<uint32_t>& getOffsets(Component component) const {
+        return _offsets[static_cast<size_t>(component)];
+    }
+
+    // Lengths of the component,
+    // zero when the component is not present.
+    inline const std::vector<uint32_t>& getLengths(Component component) const {
+        return _lengths[static_cast<size_t>(component)];
+    }
+
+    inline std::string_view getInput(size_t index) const {
+        return _inputs[index];
+    }
+
+    std::optional<std::string_view> getComponent(size_t index, Component component) const;
+    std::optional<UriView> getView(size_t index) const;
+
+    ~UriBatch() = default;
+
+private:
+    friend void parseBatch(const std::string_view* inputs, size_t count, UriBatch& outBatch);
+    friend void parseBatchParallel(const std::string_view* inputs, size_t count,
+                                   UriBatch& outBatch, size_t threads);
+
+    std::vector<std::string_view> _inputs;
+    std::vector<uint64_t> _validity;
+    std::vector<uint8_t> _presence;
+    std::vector<HostType> _host_types;
+    std::array<std::vector<uint32_t>, kComponentsCount> _offsets;
+    std::array<std::vector<uint32_t>, kComponentsCount> _lengths;
+
+    void resize(size_t count);
+    // Parses the inputs from |begin| to |end|. Different threads
+    // can parse different ranges at the same time, as long as
+    // the ranges do not share words of the validity bitmap.
+    void parseRange(const std::string_view* inputs, size_t begin, size_t end);
+};
+
+// Parses |count| URI references starting from |inputs|.
+// The batch is overwritten, its memory is reused, so parsing
+// batches of a similar size in a loop does not allocate.
+void parseBatch(const std::string_view* inputs, size_t count, UriBatch& outBatch);
+
+UriBatch parseBatch(const std::vector<std::string_view>& inputs);
+
+// Same as parseBatch, but the inputs are split into chunks parsed
+// by |threads| worker threads, which steal chunks from each other
+// once they run out of their own. Every result is written to its
+// own place in the batch, so the results keep the input order.
+// Zero |threads| means std::thread::hardware_concurrency().
+void parseBatchParallel(const std::string_view* inputs, size_t count,
+                        UriBatch& outBatch, size_t threads = 0);
+
+UriBatch parseBatchParallel(const std::vector<std::string_view>& inputs, size_t threads = 0);
+
+// Parses every line of |buffer| in parallel, "\n" and "\r\n"
+// line endings are supported. The lines are stored in the batch
+// and available through UriBatch::getInput.
+UriBatch parseLinesParallel(std::string_view buffer, size_t threads = 0);
+
+} // namespace uri
+
+#endif // __URIC_URI_BATCH_H__
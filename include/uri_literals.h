@@ -0,0 +1,85 @@
+#ifndef __URIC_URI_LITERALS_H__
+#define __URIC_URI_LITERALS_H__
+
+#include <cstddef>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+#include "authority_view.h"
+#include "uri_view.h"
+
+#include "detail/uri_state_machine.h"
+
+namespace uri {
+
+namespace __internal {
+
+// Deliberately not constexpr: reaching it while evaluating
+// a constant expression makes the expression ill-formed,
+// therefore an invalid literal fails the compilation.
+inline void InvalidUriLiteral() {
+    std::abort();
+}
+
+} // namespace __internal
+
+// constexpr counterpart of UriView::parse.
+// Runs the same grammar, but without the vectorised scanners,
+// so that it can be evaluated at compile time.
+constexpr std::optional<UriView> ParseUriView(std::string_view input) {
+    __internal::UriStateMachine machine(/* require_scheme= */ false,
+                                        /* bulk_scan= */ false);
+    if (!machine.feed(input) || !machine.finish()) {
+        return std::nullopt;
+    }
+
+    const auto extract = [input](const __internal::UriStateMachine::Range& range) {
+        return range.present
+            ? optional_string_view_t(input.substr(range.begin, range.length()))
+            : optional_string_view_t();
+    };
+
+    std::optional<AuthorityView> authority;
+    const auto& hostType = machine.getHostType();
+    if (hostType) {
+        bool isHostIPLiteral = hostType.value() == __internal::HostType::kIPLiteral;
+        authority = std::make_optional(AuthorityView(extract(machine.getHost()).value(),
+                                                     extract(machine.getPort()),
+                                                     extract(machine.getUserInfo()),
+                                                     /* isHostIPLiteral= */ isHostIPLiteral,
+                                                     machine.getIPv4(),
+                                                     machine.getIPv6(),
+                                                     machine.getPortNumber()));
+    }
+
+    return std::make_optional(UriView(extract(machine.getScheme()),
+                                      machine.getSchemeId(),
+                                      authority,
+                                      extract(machine.getPath()).value(),
+                                      extract(machine.getQuery()),
+                                      extract(machine.getFragment())));
+}
+
+namespace literals {
+
+// A view of a hard-coded URI reference, e.g.
+//
+// constexpr auto endpoint = "https://svc/x"_uri;
+//
+// In a constant expression an invalid URI reference does not compile
+// and the view, with all the components already located, is laid out statically.
+// At runtime an invalid URI reference aborts the program.
+constexpr UriView operator""_uri(const char* text, std::size_t length) {
+    const auto view = ParseUriView(std::string_view(text, length));
+    if (!view) {
+        __internal::InvalidUriLiteral();
+    }
+    return view.value();
+}
+
+} // namespace literals
+
+} // namespace uri
+
+#endif // __URIC_URI_LITERALS_H__
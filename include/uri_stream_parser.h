@@ -0,0 +1,111 @@
+#ifndef __URIC_URI_STREAM_PARSER_H__
+#define __URIC_URI_STREAM_PARSER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "uri.h"
+
+namespace uri {
+
+namespace __internal {
+
+class UriStateMachine;
+
+} // namespace __internal
+
+// Incremental parser of a URI reference that arrives in chunks,
+// e.g. a request-target split between several socket reads.
+//
+// The chunks are not joined: components point into the chunks
+// they have been read from, therefore the chunks should outlive
+// the parser. Components spanning several chunks are copied
+// only on request.
+//
+// A moved-from parser can only be assigned to or destroyed.
+class UriStreamParser {
+public:
+    enum class Status: uint8_t {
+        // The input so far is a valid beginning of a URI reference.
+        kNeedMore = 0,
+        // The input is a valid URI reference.
+        kDone,
+        // The input cannot be a URI reference.
+        kError
+    };
+
+    enum class Component: uint8_t {
+        kScheme = 0,
+        kUserInfo,
+        kHost,
+        kPort,
+        kPath,
+        kQuery,
+        kFragment
+    };
+
+    UriStreamParser();
+
+    UriStreamParser(const UriStreamParser& that) = delete;
+    UriStreamParser& operator=(const UriStreamParser& that) = delete;
+    UriStreamParser(UriStreamParser&& that) noexcept;
+    UriStreamParser& operator=(UriStreamParser&& that) noexcept;
+
+    // Consumes the next chunk. The error is reported
+    // as soon as the chunk with the offending byte arrives.
+    // Chunks that follow the end of the input are rejected with kError,
+    // the parser keeps its status, empty chunks are always ignored.
+    Status feed(std::string_view chunk);
+
+    // Marks the end of the input.
+    Status finish();
+
+    inline Status getStatus() const {
+        return _status;
+    }
+
+    // Offset of the offending byte from the beginning of the input.
+    size_t getErrorPosition() const;
+
+    // Whether the component is present, available once the parser is done.
+    bool hasComponent(Component component) const;
+
+    // Points into the chunk the component has been read from.
+    // std::nullopt when the component is absent or spans several chunks.
+    std::optional<std::string_view> getComponentView(Component component) const;
+
+    // Joins the pieces of the component from all the chunks it spans.
+    std::optional<std::string> copyComponent(Component component) const;
+
+    bool isHostIPLiteral() const;
+
+    // Joins the chunks into the buffer of a Uri.
+    std::optional<Uri> toUri(const Uri::allocator_type& allocator = Uri::allocator_type()) const;
+
+    ~UriStreamParser();
+
+private:
+    struct Chunk {
+        // Offset of the chunk from the beginning of the input.
+        size_t offset;
+        std::string_view text;
+    };
+
+    std::unique_ptr<__internal::UriStateMachine> _machine;
+    std::vector<Chunk> _chunks;
+    Status _status;
+
+    const __internal::UriStateMachine& machine() const;
+    __internal::UriStateMachine& machine();
+
+    bool getRange(Component component, size_t& outBegin, size_t& outEnd) const;
+};
+
+} // namespace uri
+
+#endif // __URIC_URI_STREAM_PARSER_H__
@@ -0,0 +1,136 @@
+#ifndef __URIC_URI_VIEW_H__
+#define __URIC_URI_VIEW_H__
+
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#include "authority_view.h"
+#include "parse_result.h"
+#include "scheme_id.h"
+
+#include "detail/scheme_recognizer.h"
+
+namespace {
+
+using optional_string_view_t = std::optional<std::string_view>;
+
+} // namespace
+
+namespace uri {
+
+// Non-owning counterpart of Uri.
+// Parsing into a view does not copy any of the components:
+// they point into the buffer the view has been parsed from,
+// therefore the buffer should outlive the view.
+class UriView {
+public:
+    static std::optional<UriView> parse(std::string_view input);
+    // Same as parse, but reports why the input has been rejected.
+    static ParseResult<UriView> tryParse(std::string_view input);
+
+    constexpr UriView(const optional_string_view_t& scheme,
+                      const std::optional<AuthorityView>& authority,
+                      std::string_view path,
+                      const optional_string_view_t& query = std::nullopt,
+                      const optional_string_view_t& fragment = std::nullopt) noexcept:
+        UriView(scheme,
+                scheme ? __internal::RecognizeScheme(scheme.value()) : SchemeId::kNone,
+                authority, path, query, fragment) {
+        // Empty on purpose.
+    }
+
+    // Same as above, but with the scheme already recognised, e.g. by the parser.
+    constexpr UriView(const optional_string_view_t& scheme,
+                      SchemeId scheme_id,
+                      const std::optional<AuthorityView>& authority,
+                      std::string_view path,
+                      const optional_string_view_t& query = std::nullopt,
+                      const optional_string_view_t& fragment = std::nullopt) noexcept:
+        _scheme(scheme),
+        _scheme_id(scheme_id),
+        _authority(authority),
+        _path(path),
+        _query(query),
+        _fragment(fragment) {
+        // Empty on purpose.
+    }
+
+    constexpr UriView(const UriView& that) = default;
+    constexpr UriView& operator=(const UriView& that) = default;
+    constexpr UriView(UriView&& that) = default;
+    constexpr UriView& operator=(UriView&& that) = default;
+
+    bool operator==(const UriView& that) const {
+        return (_scheme == that._scheme)
+        && (_authority == that._authority)
+        && (_path == that._path)
+        && (_query == that._query)
+        && (_fragment == that._fragment);
+    }
+
+    bool operator!=(const UriView& that) const {
+        return !operator==(that);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const UriView& that) {
+        if (that._scheme) {
+            stream << that._scheme.value() << ':';
+        }
+
+        if (that._authority) {
+            stream << "//" << that._authority.value();
+        }
+
+        stream << that._path;
+
+        if (that._query) {
+            stream << '?' << that._query.value();
+        }
+
+        if (that._fragment) {
+            stream << '#' << that._fragment.value();
+        }
+
+        return stream;
+    }
+
+    inline constexpr const optional_string_view_t& getScheme() const {
+        return _scheme;
+    }
+
+    // The well-known scheme, whatever its case, see Uri::getSchemeId.
+    inline constexpr SchemeId getSchemeId() const {
+        return _scheme_id;
+    }
+
+    inline constexpr const std::optional<AuthorityView>& getAuthority() const {
+        return _authority;
+    }
+
+    inline constexpr std::string_view getPath() const {
+        return _path;
+    }
+
+    inline constexpr const optional_string_view_t& getQuery() const {
+        return _query;
+    }
+
+    inline constexpr const optional_string_view_t& getFragment() const {
+        return _fragment;
+    }
+
+    ~UriView() = default;
+
+private:
+    optional_string_view_t _scheme;
+    SchemeId _scheme_id;
+    std::optional<AuthorityView> _authority;
+    std::string_view _path;
+    optional_string_view_t _query;
+    optional_string_view_t _fragment;
+};
+
+} // namespace uri
+
+#endif // __URIC_URI_VIEW_H__
@@ -1,12 +1,18 @@
 #ifndef __URIC_URL_H__
 #define __URIC_URL_H__
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
 #include <optional>
 #include <string>
-#include <sstream>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
 
 #include "authority.h"
+#include "query_params.h"
+#include "query_view.h"
 #include "uri.h"
 
 namespace {
@@ -17,179 +23,241 @@ using optional_string_t = std::optional<std::string>;
 
 namespace uri {
 
-constexpr char kQueryItemsSeparator = '&';
-constexpr char kQueryKeyValueSeparator = '=';
-
 class Url {
 public:
-    using query_params_t = std::unordered_map<std::string, std::string>;
+    // Both the URI reference and the query parameters
+    // are allocated with the allocator.
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    using query_params_t = QueryParams;
 
-    static std::optional<Url> parse(const std::string& input) {
-        const auto& uri_opt = Uri::parse(input);
+    static std::optional<Url> parse(std::string_view input,
+                                    const allocator_type& allocator = allocator_type()) {
+        auto uri_opt = Uri::parse(input, allocator);
 
         if (!uri_opt) {
             return std::nullopt;
         }
 
-        return Url(uri_opt.value());
+        return Url(std::move(uri_opt.value()), allocator);
     }
 
-    static std::optional<Url> fromParts(const std::string& raw_path,
-                                        const optional_string_t& raw_scheme,
-                                        const optional_string_t& raw_authority,
-                                        const optional_string_t& raw_query,
-                                        const optional_string_t& raw_fragment) {
-        const auto& uri_opt = Uri::fromParts(raw_path, raw_scheme, raw_authority, raw_query, raw_fragment);
+    static std::optional<Url> fromParts(std::string_view raw_path,
+                                        const optional_string_view_t& raw_scheme,
+                                        const optional_string_view_t& raw_authority,
+                                        const optional_string_view_t& raw_query,
+                                        const optional_string_view_t& raw_fragment,
+                                        const allocator_type& allocator = allocator_type()) {
+        auto uri_opt = Uri::fromParts(raw_path, raw_scheme, raw_authority, raw_query, raw_fragment, allocator);
 
         if (!uri_opt) {
             return std::nullopt;
         }
 
-        return Url(uri_opt.value());
+        return Url(std::move(uri_opt.value()), allocator);
     }
 
-    explicit Url(const Uri& uri) noexcept:
-        _uri(uri),
-        _query_params(Url::parseQueryParams(uri.getQuery())) {
+    explicit Url(const Uri& uri,
+                 const allocator_type& allocator = allocator_type()) noexcept:
+        _uri(uri, allocator),
+        _query_params(nullptr) {
         // Empty on purpose.
     }
 
-    explicit Url(const std::string& path,
-                 const optional_string_t& query = std::nullopt,
-                 const optional_string_t& fragment = std::nullopt) noexcept:
-        _uri(path, query, fragment),
-        _query_params(Url::parseQueryParams(query)) {
+    explicit Url(Uri&& uri,
+                 const allocator_type& allocator = allocator_type()) noexcept:
+        _uri(std::move(uri), allocator),
+        _query_params(nullptr) {
         // Empty on purpose.
     }
 
-    Url(const optional_string_t& scheme,
-        const std::optional<Authority>& authority,
-        const std::string& path,
-        const optional_string_t& query = std::nullopt,
-        const optional_string_t& fragment = std::nullopt) noexcept:
-        _uri(scheme, authority, path, query, fragment),
-        _query_params(Url::parseQueryParams(query)) {
+    explicit Url(std::string_view path,
+                 const optional_string_view_t& query = std::nullopt,
+                 const optional_string_view_t& fragment = std::nullopt,
+                 const allocator_type& allocator = allocator_type()) noexcept:
+        _uri(path, query, fragment, allocator),
+        _query_params(nullptr) {
         // Empty on purpose.
     }
 
-    Url(const Url& that) = default;
-    Url& operator=(const Url& that) = default;
-    Url(Url&& that) = default;
-    Url& operator=(Url&& that) = default;
+    Url(const optional_string_view_t& scheme,
+        const std::optional<Authority>& authority,
+        std::string_view path,
+        const optional_string_view_t& query = std::nullopt,
+        const optional_string_view_t& fragment = std::nullopt,
+        const allocator_type& allocator = allocator_type()) noexcept:
+        _uri(scheme, authority, path, query, fragment, allocator),
+        _query_params(nullptr) {
+        // Empty on purpose.
+    }
 
-    bool operator==(const Url& that) const {
-        return (_uri == that._uri);
+    // Copies parse the query again on demand,
+    // so copying never copies the parameters.
+    Url(const Url& that) noexcept:
+        _uri(that._uri),
+        _query_params(nullptr) {
+        // Empty on purpose.
     }
 
-    bool operator!=(const Url& that) const {
-        return !operator==(that);
+    Url(Url&& that) noexcept:
+        _uri(std::move(that._uri)),
+        _query_params(that._query_params.exchange(nullptr, std::memory_order_acq_rel)) {
+        // Empty on purpose.
     }
 
-    friend std::ostream& operator<<(std::ostream& stream, const Url& that) { 
-        if (that._uri.getScheme()) {
-            stream << that._uri.getScheme().value() << ':';
-        }
+    Url(const Url& that, const allocator_type& allocator) noexcept:
+        _uri(that._uri, allocator),
+        _query_params(nullptr) {
+        // Empty on purpose.
+    }
 
-        if (that._uri.getAuthority()) {
-            stream << "//" << that._uri.getAuthority().value();
+    Url(Url&& that, const allocator_type& allocator) noexcept:
+        _uri(std::move(that._uri), allocator),
+        _query_params(nullptr) {
+        // The parameters can only be taken over when
+        // they are allocated with the same allocator.
+        if (that.get_allocator() == allocator) {
+            _query_params.store(that._query_params.exchange(nullptr, std::memory_order_acq_rel),
+                                std::memory_order_release);
         }
+    }
 
-        stream << that._uri.getPath();
-
-        if (that._uri.getQuery()) {
-            stream << '?' << that._uri.getQuery().value();
+    Url& operator=(const Url& that) {
+        if (this != &that) {
+            _uri = that._uri;
+            resetQueryParams(nullptr);
         }
+        return *this;
+    }
 
-        if (that._uri.getFragment()) {
-            stream << '#' << that._uri.getFragment().value();
+    Url& operator=(Url&& that) {
+        if (this != &that) {
+            const bool same_allocator = (get_allocator() == that.get_allocator());
+            _uri = std::move(that._uri);
+            resetQueryParams(same_allocator ? that._query_params.exchange(nullptr, std::memory_order_acq_rel) : nullptr);
         }
+        return *this;
+    }
 
-        return stream;
+    bool operator==(const Url& that) const {
+        return (_uri == that._uri);
     }
 
-    inline const optional_string_t& getScheme() const {
-        return _uri.getScheme();
+    bool operator!=(const Url& that) const {
+        return !operator==(that);
     }
 
-    inline const std::optional<Authority>& getAuthority() const {
-        return _uri.getAuthority();
+    friend std::ostream& operator<<(std::ostream& stream, const Url& that) {
+        return stream << that._uri;
     }
 
-    inline const std::string& getPath() const {
-        return _uri.getPath();
+    // The hash of the URI reference, see Uri::getHash.
+    inline uint64_t getHash() const {
+        return _uri.getHash();
     }
 
-    inline const query_params_t& getQuery() const {
-        return _query_params;
+    inline optional_string_view_t getScheme() const {
+        return _uri.getScheme();
     }
 
-    inline const optional_string_t& getFragment() const {
-        return _uri.getFragment();
+    inline SchemeId getSchemeId() const {
+        return _uri.getSchemeId();
     }
 
-    ~Url() = default;
+    inline std::optional<AuthorityView> getAuthority() const {
+        return _uri.getAuthority();
+    }
 
-private:
-    Uri _uri;
-    query_params_t _query_params;
+    inline std::string_view getPath() const {
+        return _uri.getPath();
+    }
 
-    static query_params_t parseQueryParams(const optional_string_t& raw_opt_query) {
-        if (!raw_opt_query) {
-            return std::unordered_map<std::string, std::string>();
+    // The query is parsed on the first call, concurrent
+    // calls on the same Url are safe.
+    const query_params_t& getQuery() const {
+        const query_params_t* query_params = _query_params.load(std::memory_order_acquire);
+        if (query_params != nullptr) {
+            return *query_params;
         }
 
-        std::unordered_map<std::string, std::string> queries;
+        const auto& query = _uri.getQuery();
+        if (!query) {
+            // Nothing to parse, no need to allocate.
+            static const query_params_t kEmptyQueryParams;
+            return kEmptyQueryParams;
+        }
 
-        const auto& raw_query = raw_opt_query.value();
+        std::pmr::polymorphic_allocator<query_params_t> allocator(get_allocator());
+        query_params_t* parsed = allocator.allocate(1);
+        try {
+            allocator.construct(parsed, query.value());
+        } catch (...) {
+            allocator.deallocate(parsed, 1);
+            throw;
+        }
 
-        size_t i = 0;
-        bool keyValueSeparatorFound = false;
-        std::stringstream keyBuffer;
-        std::stringstream valueBuffer;
-        while (i < raw_query.length()) {
-            if (raw_query[i] == kQueryItemsSeparator) {
-                const auto& key = keyBuffer.str();
-                const auto& value = valueBuffer.str();
+        // Threads may race to parse the query, the first one wins.
+        const query_params_t* expected = nullptr;
+        if (!_query_params.compare_exchange_strong(expected, parsed,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+            parsed->~query_params_t();
+            allocator.deallocate(parsed, 1);
+            return *expected;
+        }
+        return *parsed;
+    }
 
-                if (keyValueSeparatorFound || key.length() > 0) {
-                    queries[key] = value;
-                }
+    // Items of the query found on demand, without copies.
+    inline QueryView getQueryView() const {
+        const auto& query = _uri.getQuery();
+        return query ? QueryView(query.value()) : QueryView();
+    }
 
-                keyValueSeparatorFound = false;
-                keyBuffer.str("");
-                valueBuffer.str("");
+    inline optional_string_view_t getFragment() const {
+        return _uri.getFragment();
+    }
 
-                i++;
-                continue;
-            }
+    inline const Uri& getUri() const {
+        return _uri;
+    }
 
-            if (!keyValueSeparatorFound && raw_query[i] == kQueryKeyValueSeparator) {
-                keyValueSeparatorFound = true;
+    inline allocator_type get_allocator() const {
+        return _uri.get_allocator();
+    }
 
-                i++;
-                continue;
-            }
+    ~Url() {
+        resetQueryParams(nullptr);
+    }
 
-            if (!keyValueSeparatorFound) {
-                keyBuffer << raw_query[i];
-            } else {
-                valueBuffer << raw_query[i];
-            }
+private:
+    Uri _uri;
+    // Null until the query has been parsed.
+    mutable std::atomic<const query_params_t*> _query_params;
 
-            i++;
+    void resetQueryParams(const query_params_t* query_params) {
+        const query_params_t* previous = _query_params.exchange(query_params, std::memory_order_acq_rel);
+        if (previous == nullptr) {
+            return;
         }
 
-        const auto& key = keyBuffer.str();
-        const auto& value = valueBuffer.str();
+        std::pmr::polymorphic_allocator<query_params_t> allocator(get_allocator());
+        query_params_t* owned = const_cast<query_params_t*>(previous);
+        owned->~query_params_t();
+        allocator.deallocate(owned, 1);
+    }
+};
 
-        if (keyValueSeparatorFound || key.length() > 0) {
-            queries[key] = value;
-        }
+} // namespace uri
+
+namespace std {
 
-        return queries;
+template<>
+struct hash<uri::Url> {
+    size_t operator()(const uri::Url& url) const noexcept {
+        return static_cast<size_t>(url.getHash());
     }
 };
 
-} // namespace uri
+} // namespace std
 
 #endif // __URIC_URL_H__
@@ -28,7 +28,7 @@ int main(int argc, char *argv[]) {
     }
 
     if (uri.getAuthority()) {
-        const auto& authority = uri.getAuthority().value();
+        const auto authority = uri.getAuthority().value();
 
         std::cout << "Authority:" << std::endl;
         if (authority.getUserInfo()) {
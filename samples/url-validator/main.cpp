@@ -28,7 +28,7 @@ int main(int argc, char *argv[]) {
     }
 
     if (url.getAuthority()) {
-        const auto& authority = url.getAuthority().value();
+        const auto authority = url.getAuthority().value();
 
         std::cout << "Authority:" << std::endl;
         if (authority.getUserInfo()) {
@@ -1,25 +1,42 @@
 #include "authority.h"
 
-#include "uri_parser.h"
-#include "token_reader.h"
+#include "hashing.h"
 
 namespace uri {
 
-std::optional<Authority> Authority::parse(const std::string& input) {
-    __internal::TokenReader reader(input);
+std::optional<Authority> Authority::parse(std::string_view input,
+                                           const allocator_type& allocator) {
+    const auto& view_opt = AuthorityView::parse(input);
 
-    optional_string_t outUserInfo;
-    optional_string_t outHost;
-    std::optional<__internal::HostType> outHostType;
-    optional_string_t outPort;
-    authority(reader, outUserInfo, outHost, outHostType, outPort);
-
-    if (reader.hasNext() || !outHost || !outHostType) {
+    if (!view_opt) {
         return std::nullopt;
     }
 
-    bool isHostIPLiteral = outHostType.value() == uri::__internal::HostType::kIPLiteral;
-    return Authority(outHost.value(), outPort, outUserInfo, /* isHostIPLiteral= */ isHostIPLiteral);
+    return Authority(view_opt.value(), allocator);
+}
+
+uint64_t Authority::hashOf(std::string_view host,
+                           const optional_string_view_t& port,
+                           const optional_string_view_t& userInfo,
+                           bool is_host_ip_literal) {
+    // Hashes the serialised authority, as it is streamed.
+    __internal::Hasher hasher;
+    if (userInfo) {
+        hasher.update(userInfo.value());
+        hasher.update(std::string_view(&kUserInfoSeparator, 1));
+    }
+    if (is_host_ip_literal) {
+        hasher.update(std::string_view(&kIPLiteralBegin, 1));
+    }
+    hasher.update(host);
+    if (is_host_ip_literal) {
+        hasher.update(std::string_view(&kIPLiteralEnd, 1));
+    }
+    if (port) {
+        hasher.update(std::string_view(&kPortSeparator, 1));
+        hasher.update(port.value());
+    }
+    return hasher.hash();
 }
 
 } // namepsace uri
@@ -0,0 +1,28 @@
+#include "authority_view.h"
+
+#include "uri_parser.h"
+#include "token_reader.h"
+
+namespace uri {
+
+std::optional<AuthorityView> AuthorityView::parse(std::string_view input) {
+    __internal::TokenReader reader(input);
+
+    optional_string_view_t outUserInfo;
+    optional_string_view_t outHost;
+    std::optional<__internal::HostType> outHostType;
+    optional_string_view_t outPort;
+    authority(reader, outUserInfo, outHost, outHostType, outPort);
+
+    if (reader.hasNext() || !outHost || !outHostType) {
+        return std::nullopt;
+    }
+
+    bool isHostIPLiteral = outHostType.value() == uri::__internal::HostType::kIPLiteral;
+    return AuthorityView(outHost.value(),
+                         outPort,
+                         outUserInfo,
+                         /* isHostIPLiteral= */ isHostIPLiteral);
+}
+
+} // namepsace uri
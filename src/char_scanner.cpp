@@ -0,0 +1,238 @@
+#include "detail/char_scanner.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define URIC_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using uri::__internal::CharClassSet;
+using uri::__internal::HasCharClass;
+using uri::__internal::kHexDigit;
+
+constexpr char kPercent = '%';
+
+// Whether a valid triplet starts at |i|, the percent sign included.
+inline bool IsPctEncodedAt(std::string_view text, size_t i) {
+    return i + 2 < text.length() &&
+           text[i] == kPercent &&
+           HasCharClass(text[i + 1], kHexDigit) &&
+           HasCharClass(text[i + 2], kHexDigit);
+}
+
+// Continues a scan from |i| byte by byte.
+size_t ScanScalarFrom(std::string_view text, size_t i, const CharClassSet& set) {
+    while (i < text.length()) {
+        if (HasCharClass(text[i], set.char_class)) {
+            i += 1;
+        } else if (set.pct_encoded && IsPctEncodedAt(text, i)) {
+            i += 3;
+        } else {
+            break;
+        }
+    }
+
+    return i;
+}
+
+#if defined(URIC_X86_KERNELS)
+
+inline uint32_t CountTrailingZeros(uint32_t value) {
+    return static_cast<uint32_t>(__builtin_ctz(value));
+}
+
+// Hex digits bits of the two bytes after a block,
+// percent-encoded triplets may cross the block boundary.
+inline uint64_t HexDigitsAfterBlock(std::string_view text, size_t block_end, uint32_t block_size) {
+    uint64_t bits = 0;
+    if (block_end < text.length() && HasCharClass(text[block_end], kHexDigit)) {
+        bits |= 1ULL << block_size;
+    }
+    if (block_end + 1 < text.length() && HasCharClass(text[block_end + 1], kHexDigit)) {
+        bits |= 1ULL << (block_size + 1);
+    }
+    return bits;
+}
+
+// Returns the offset of the first byte within a block of |block_size| bytes
+// that stops the scan, or |block_size| if the block is entirely valid.
+// |allowed| has a bit per byte of the set (percent sign included),
+// |percents| and |hex_digits| mark percent signs and hex digits.
+// Hex digits of valid triplets are accepted even when the set does not
+// have them, e.g. "A" in "%2A" for lowercase hosts. |triplet_tail| marks
+// the leading bytes that finish a triplet of the previous block,
+// and is updated for the next block.
+inline uint32_t FindStopInBlock(std::string_view text, size_t block_start, uint32_t block_size,
+                                uint32_t allowed, uint32_t percents, uint32_t hex_digits,
+                                uint32_t& triplet_tail) {
+    const uint32_t block_mask = block_size == 32 ? ~0U : ((1U << block_size) - 1);
+
+    uint64_t accepted = allowed | triplet_tail;
+    uint64_t stops = 0;
+    triplet_tail = 0;
+
+    if (percents != 0) {
+        uint64_t hex = hex_digits | HexDigitsAfterBlock(text, block_start + block_size, block_size);
+        uint64_t valid_triplets = percents & (hex >> 1) & (hex >> 2);
+        uint64_t triplet_digits = (valid_triplets << 1) | (valid_triplets << 2);
+        accepted |= triplet_digits;
+        stops |= percents & ~valid_triplets;
+        triplet_tail = static_cast<uint32_t>(triplet_digits >> block_size) & 0x3;
+    }
+
+    stops |= ~accepted;
+    stops &= block_mask;
+    if (stops == 0) {
+        return block_size;
+    }
+
+    return CountTrailingZeros(static_cast<uint32_t>(stops));
+}
+
+// Number of bytes of a triplet left over by the last block.
+inline size_t TripletTailLength(uint32_t triplet_tail) {
+    return static_cast<size_t>(__builtin_popcount(triplet_tail));
+}
+
+__attribute__((target("ssse3")))
+inline __m128i ClassifySsse3(__m128i bytes, __m128i low_table, __m128i high_table) {
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    __m128i low = _mm_and_si128(bytes, nibble_mask);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask);
+    __m128i rows = _mm_shuffle_epi8(low_table, low);
+    __m128i row = _mm_shuffle_epi8(high_table, high);
+    __m128i miss = _mm_cmpeq_epi8(_mm_and_si128(rows, row), _mm_setzero_si128());
+    return _mm_xor_si128(miss, _mm_set1_epi8(static_cast<char>(0xFF)));
+}
+
+__attribute__((target("ssse3")))
+size_t ScanSsse3(std::string_view text, const CharClassSet& set) {
+    static constexpr CharClassSet kHexSet = uri::__internal::MakeCharClassSet(kHexDigit);
+
+    const __m128i low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low_nibbles.data()));
+    const __m128i hex_low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexSet.low_nibbles.data()));
+    // Rows 8-15 are not ASCII and never belong to a class.
+    const __m128i high_table = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, static_cast<char>(128),
+                                             0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i percent = _mm_set1_epi8(kPercent);
+
+    size_t i = 0;
+    uint32_t triplet_tail = 0;
+    while (i + 16 <= text.length()) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+
+        uint32_t allowed = static_cast<uint32_t>(_mm_movemask_epi8(ClassifySsse3(bytes, low_table, high_table)));
+        uint32_t percents = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, percent)));
+        uint32_t hex_digits = 0;
+        if (percents != 0) {
+            // The hex set contains the percent sign as well, remove it.
+            hex_digits = static_cast<uint32_t>(_mm_movemask_epi8(ClassifySsse3(bytes, hex_low_table, high_table))) & ~percents;
+        }
+
+        uint32_t stop = FindStopInBlock(text, i, 16, allowed, percents, hex_digits, triplet_tail);
+        if (stop < 16) {
+            return i + stop;
+        }
+
+        i += 16;
+    }
+
+    return ScanScalarFrom(text, i + TripletTailLength(triplet_tail), set);
+}
+
+__attribute__((target("avx2")))
+inline __m256i ClassifyAvx2(__m256i bytes, __m256i low_table, __m256i high_table) {
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    __m256i low = _mm256_and_si256(bytes, nibble_mask);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble_mask);
+    __m256i rows = _mm256_shuffle_epi8(low_table, low);
+    __m256i row = _mm256_shuffle_epi8(high_table, high);
+    __m256i miss = _mm256_cmpeq_epi8(_mm256_and_si256(rows, row), _mm256_setzero_si256());
+    return _mm256_xor_si256(miss, _mm256_set1_epi8(static_cast<char>(0xFF)));
+}
+
+__attribute__((target("avx2")))
+size_t ScanAvx2(std::string_view text, const CharClassSet& set) {
+    static constexpr CharClassSet kHexSet = uri::__internal::MakeCharClassSet(kHexDigit);
+
+    // The shuffle works within 128-bit lanes, so the tables are duplicated.
+    const __m256i low_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low_nibbles.data())));
+    const __m256i hex_low_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexSet.low_nibbles.data())));
+    const __m256i high_table = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, static_cast<char>(128),
+                      0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i percent = _mm256_set1_epi8(kPercent);
+
+    size_t i = 0;
+    uint32_t triplet_tail = 0;
+    while (i + 32 <= text.length()) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + i));
+
+        uint32_t allowed = static_cast<uint32_t>(_mm256_movemask_epi8(ClassifyAvx2(bytes, low_table, high_table)));
+        uint32_t percents = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, percent)));
+        uint32_t hex_digits = 0;
+        if (percents != 0) {
+            hex_digits = static_cast<uint32_t>(_mm256_movemask_epi8(ClassifyAvx2(bytes, hex_low_table, high_table))) & ~percents;
+        }
+
+        uint32_t stop = FindStopInBlock(text, i, 32, allowed, percents, hex_digits, triplet_tail);
+        if (stop < 32) {
+            return i + stop;
+        }
+
+        i += 32;
+    }
+
+    // Leaving AVX state dirty slows down the SSE code after the scan.
+    _mm256_zeroupper();
+    return ScanScalarFrom(text, i + TripletTailLength(triplet_tail), set);
+}
+
+using scan_function_t = size_t (*)(std::string_view, const CharClassSet&);
+
+scan_function_t SelectScanFunction() {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return ScanAvx2;
+    }
+
+    if (__builtin_cpu_supports("ssse3")) {
+        return ScanSsse3;
+    }
+
+    return uri::__internal::ScanCharClassScalar;
+}
+
+#endif // URIC_X86_KERNELS
+
+} // namespace
+
+namespace uri {
+
+namespace __internal {
+
+size_t ScanCharClass(std::string_view text, const CharClassSet& set) {
+#if defined(URIC_X86_KERNELS)
+    // Short inputs are not worth a vector load.
+    if (text.length() < 16) {
+        return ScanScalarFrom(text, 0, set);
+    }
+
+    static const scan_function_t scan_function = SelectScanFunction();
+    return scan_function(text, set);
+#else
+    return ScanScalarFrom(text, 0, set);
+#endif
+}
+
+size_t ScanCharClassScalar(std::string_view text, const CharClassSet& set) {
+    return ScanScalarFrom(text, 0, set);
+}
+
+} // namespace __internal
+
+} // namespace uri
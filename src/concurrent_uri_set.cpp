@@ -0,0 +1,294 @@
+#include "concurrent_uri_set.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+// A slot is a single word: zero when empty, otherwise 31 bits
+// of the fingerprint as a tag and the index of the entry plus one.
+// Migrated slots are sealed, so nothing is inserted into them anymore,
+// but they keep their entries for the lookups still reading them.
+constexpr uint64_t kSealed = 1ULL << 63;
+constexpr uint64_t kTagMask = 0x7FFFFFFFULL << 32;
+constexpr uint64_t kEntryMask = 0xFFFFFFFFULL;
+
+constexpr size_t kMinTableSize = 16;
+// Slots moved at once by an insertion that helps growing.
+constexpr size_t kMigrationChunk = 1024;
+constexpr size_t kFirstSegmentSize = 1024;
+
+inline uint64_t TagOf(const uri::Fingerprint& fingerprint) {
+    return (fingerprint.low >> 1) & kTagMask;
+}
+
+inline size_t FloorLog2(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - static_cast<size_t>(__builtin_clzll(value));
+#else
+    size_t log = 0;
+    while (value >>= 1) {
+        log++;
+    }
+    return log;
+#endif
+}
+
+// Segment |i| holds kFirstSegmentSize * 2^i entries.
+inline std::pair<size_t, size_t> SegmentOf(uint32_t entry) {
+    const size_t segment = FloorLog2(entry / kFirstSegmentSize + 1);
+    return std::make_pair(segment, entry - kFirstSegmentSize * ((size_t(1) << segment) - 1));
+}
+
+} // namespace
+
+namespace uri {
+
+struct ConcurrentUriSet::Table {
+    explicit Table(size_t size):
+        mask(size - 1),
+        slots(new std::atomic<uint64_t>[size]()),
+        used(0),
+        next(nullptr),
+        claimed(0),
+        migrated(0) {
+        // Empty on purpose.
+    }
+
+    inline size_t size() const {
+        return mask + 1;
+    }
+
+    const size_t mask;
+    std::unique_ptr<std::atomic<uint64_t>[]> slots;
+    std::atomic<size_t> used;
+    // The table the slots move to, once this one is half full.
+    std::atomic<Table*> next;
+    // Slots claimed by and moved by the helping insertions.
+    std::atomic<size_t> claimed;
+    std::atomic<size_t> migrated;
+};
+
+ConcurrentUriSet::ConcurrentUriSet(size_t capacity):
+    _current(nullptr),
+    _first(nullptr),
+    _segments(),
+    _entries_count(0),
+    _size(0) {
+    size_t size = kMinTableSize;
+    while (size < 2 * capacity) {
+        size *= 2;
+    }
+
+    _first = new Table(size);
+    _current.store(_first, std::memory_order_release);
+    for (auto& segment: _segments) {
+        segment.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ConcurrentUriSet::~ConcurrentUriSet() {
+    Table* table = _first;
+    while (table != nullptr) {
+        Table* next = table->next.load(std::memory_order_relaxed);
+        delete table;
+        table = next;
+    }
+
+    for (auto& segment: _segments) {
+        delete[] segment.load(std::memory_order_relaxed);
+    }
+}
+
+std::pair<ConcurrentUriSet::Handle, bool> ConcurrentUriSet::insertIfAbsent(const Uri& uri, Handle handle) {
+    return insertIfAbsent(uri.getNormalisedFingerprint(), handle);
+}
+
+std::pair<ConcurrentUriSet::Handle, bool> ConcurrentUriSet::insertIfAbsent(const Fingerprint& fingerprint, Handle handle) {
+    Table* table = _current.load(std::memory_order_acquire);
+    helpMigrate(table);
+
+    // The entry is only allocated once a free slot is found.
+    uint64_t value = 0;
+    const uint64_t slot = publish(table, fingerprint, value, handle);
+    if (slot != value) {
+        return std::make_pair(entryOf(slot).handle, false);
+    }
+
+    _size.fetch_add(1, std::memory_order_relaxed);
+    return std::make_pair(handle, true);
+}
+
+std::optional<ConcurrentUriSet::Handle> ConcurrentUriSet::find(const Uri& uri) const {
+    return find(uri.getNormalisedFingerprint());
+}
+
+std::optional<ConcurrentUriSet::Handle> ConcurrentUriSet::find(const Fingerprint& fingerprint) const {
+    const uint64_t tag = TagOf(fingerprint);
+
+    Table* table = _current.load(std::memory_order_acquire);
+    while (table != nullptr) {
+        size_t index = static_cast<size_t>(fingerprint.high) & table->mask;
+        for (size_t probes = 0; probes < table->size(); probes++, index = (index + 1) & table->mask) {
+            const uint64_t slot = table->slots[index].load(std::memory_order_acquire);
+            if (slot == 0) {
+                // Insertions take the first free slot, and slots are never
+                // freed: the fingerprint is in no table.
+                return std::nullopt;
+            }
+            if (slot == kSealed) {
+                // Free when sealed, so the fingerprint can only be in the next table.
+                break;
+            }
+            if (matches(slot, tag, fingerprint)) {
+                return entryOf(slot).handle;
+            }
+        }
+        table = table->next.load(std::memory_order_acquire);
+    }
+    return std::nullopt;
+}
+
+const ConcurrentUriSet::Entry& ConcurrentUriSet::entryOf(uint64_t slot) const {
+    const auto segment = SegmentOf(static_cast<uint32_t>((slot & kEntryMask) - 1));
+    return _segments[segment.first].load(std::memory_order_acquire)[segment.second];
+}
+
+uint64_t ConcurrentUriSet::allocateEntry(const Fingerprint& fingerprint, uint64_t tag, Handle handle) {
+    const uint32_t entry = _entries_count.fetch_add(1, std::memory_order_relaxed);
+    const auto segment = SegmentOf(entry);
+
+    Entry* entries = _segments[segment.first].load(std::memory_order_acquire);
+    if (entries == nullptr) {
+        // Threads may race to allocate the segment, the first one wins.
+        Entry* allocated = new Entry[kFirstSegmentSize << segment.first];
+        if (_segments[segment.first].compare_exchange_strong(entries, allocated,
+                                                             std::memory_order_acq_rel,
+                                                             std::memory_order_acquire)) {
+            entries = allocated;
+        } else {
+            delete[] allocated;
+        }
+    }
+
+    // Published with the slot.
+    entries[segment.second] = Entry { fingerprint, handle };
+    return tag | (static_cast<uint64_t>(entry) + 1);
+}
+
+bool ConcurrentUriSet::matches(uint64_t slot, uint64_t tag, const Fingerprint& fingerprint) const {
+    return ((slot & kTagMask) == tag) && (entryOf(slot).fingerprint == fingerprint);
+}
+
+// Linear probing from |table| on: the fingerprint is either found in
+// the slots of its chain, or its chain ends in a free slot where |value|
+// is published. A sealed free slot ends the chain in this table,
+// the fingerprint goes on to the next one. Returns the slot holding the
+// fingerprint, |value| when it is published. A zero |value| is allocated
+// as a new entry with |handle| once it is needed.
+uint64_t ConcurrentUriSet::publish(Table* table, const Fingerprint& fingerprint, uint64_t& value, Handle handle) {
+    const uint64_t tag = TagOf(fingerprint);
+
+    while (true) {
+        size_t index = static_cast<size_t>(fingerprint.high) & table->mask;
+        for (size_t probes = 0; probes < table->size(); probes++, index = (index + 1) & table->mask) {
+            std::atomic<uint64_t>& slot = table->slots[index];
+            uint64_t current = slot.load(std::memory_order_acquire);
+
+            while (current == 0) {
+                if (value == 0) {
+                    value = allocateEntry(fingerprint, tag, handle);
+                }
+                if (slot.compare_exchange_strong(current, value,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                    // Exactly one insertion makes the table half full.
+                    if (table->used.fetch_add(1, std::memory_order_relaxed) + 1 == table->size() / 2 + 1) {
+                        grow(table);
+                    }
+                    return value;
+                }
+            }
+
+            if (current == kSealed) {
+                break;
+            }
+            if (matches(current, tag, fingerprint)) {
+                return current & ~kSealed;
+            }
+        }
+
+        // A full table has no free slot to end the chain with, then
+        // the fingerprint goes on to the next table as well.
+        Table* next = table->next.load(std::memory_order_acquire);
+        table = (next != nullptr) ? next : grow(table);
+    }
+}
+
+ConcurrentUriSet::Table* ConcurrentUriSet::grow(Table* table) {
+    Table* next = table->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        return next;
+    }
+
+    // Threads may race to grow the table, the first one wins.
+    Table* allocated = new Table(2 * table->size());
+    if (table->next.compare_exchange_strong(next, allocated,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+        return allocated;
+    }
+    delete allocated;
+    return next;
+}
+
+void ConcurrentUriSet::helpMigrate(Table* table) {
+    Table* next = table->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+        return;
+    }
+
+    const size_t begin = table->claimed.fetch_add(kMigrationChunk, std::memory_order_relaxed);
+    if (begin < table->size()) {
+        const size_t end = std::min(begin + kMigrationChunk, table->size());
+        for (size_t index = begin; index < end; index++) {
+            migrateSlot(table, index);
+        }
+
+        if (table->migrated.fetch_add(end - begin, std::memory_order_acq_rel) + (end - begin) < table->size()) {
+            return;
+        }
+    } else if (table->migrated.load(std::memory_order_acquire) < table->size()) {
+        // The last chunks are still being moved by other insertions.
+        return;
+    }
+
+    // Every slot is in the next table, new operations start from there.
+    Table* expected = table;
+    _current.compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_acquire);
+}
+
+void ConcurrentUriSet::migrateSlot(Table* table, size_t index) {
+    std::atomic<uint64_t>& slot = table->slots[index];
+    uint64_t current = slot.load(std::memory_order_acquire);
+
+    // Free slots are sealed right away, taken ones once they are copied,
+    // so lookups find them in either table meanwhile.
+    while (current == 0) {
+        if (slot.compare_exchange_strong(current, kSealed,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            return;
+        }
+    }
+    if ((current & kSealed) != 0) {
+        return;
+    }
+
+    uint64_t value = current;
+    publish(table->next.load(std::memory_order_acquire), entryOf(current).fingerprint, value, 0);
+    // Taken slots only change when sealed, another helper may have done it.
+    slot.compare_exchange_strong(current, current | kSealed, std::memory_order_acq_rel);
+}
+
+} // namespace uri
@@ -0,0 +1,143 @@
+#ifndef __URIC_HASHING_H__
+#define __URIC_HASHING_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "fingerprint.h"
+
+namespace uri {
+
+namespace __internal {
+
+// Non-cryptographic multiply-fold hash.
+//
+// Bytes are taken 8 at a time, as little-endian words, by two
+// independent lanes, so the latencies of the multiplications overlap.
+// The hash does not depend on how the bytes are split between
+// updates: feeding the pieces of a text one by one gives the same
+// hash as feeding the whole text at once, which lets normal forms
+// be hashed without being built.
+class Hasher {
+public:
+    constexpr Hasher() noexcept:
+        _lanes{ kSecrets[0], kSecrets[1] },
+        _tail(0),
+        _tail_length(0),
+        _length(0) {
+        // Empty on purpose.
+    }
+
+    inline void update(std::string_view bytes) {
+        _length += bytes.length();
+
+        size_t i = 0;
+        if (_tail_length > 0) {
+            for (; i < bytes.length() && _tail_length < 8; i++, _tail_length++) {
+                _tail |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * _tail_length);
+            }
+            if (_tail_length < 8) {
+                return;
+            }
+            consume(_tail);
+            _tail = 0;
+            _tail_length = 0;
+        }
+
+        for (; i + 8 <= bytes.length(); i += 8) {
+            consume(LoadWord(bytes.data() + i));
+        }
+
+        for (; i < bytes.length(); i++, _tail_length++) {
+            _tail |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * _tail_length);
+        }
+    }
+
+    inline Fingerprint fingerprint() const {
+        uint64_t lanes[2] = { _lanes[0], _lanes[1] };
+        if (_tail_length > 0) {
+            Consume(lanes, _tail);
+        }
+
+        return Fingerprint {
+            Mix(lanes[0] ^ kSecrets[2], lanes[1] ^ _length),
+            Mix(lanes[1] ^ kSecrets[3], lanes[0] ^ _length)
+        };
+    }
+
+    inline uint64_t hash() const {
+        return fingerprint().high;
+    }
+
+private:
+    static constexpr uint64_t kSecrets[4] = {
+        0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+    };
+
+    uint64_t _lanes[2];
+    uint64_t _tail;
+    size_t _tail_length;
+    uint64_t _length;
+
+    // The 128-bit product of |a| and |b| folded to 64 bits.
+    static inline uint64_t Mix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 uint128_t;
+        const uint128_t product = static_cast<uint128_t>(a) * b;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+        const uint64_t a_low = a & 0xFFFFFFFFULL;
+        const uint64_t a_high = a >> 32;
+        const uint64_t b_low = b & 0xFFFFFFFFULL;
+        const uint64_t b_high = b >> 32;
+
+        const uint64_t low_low = a_low * b_low;
+        const uint64_t high_low = a_high * b_low;
+        const uint64_t low_high = a_low * b_high;
+        const uint64_t high_high = a_high * b_high;
+
+        const uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFFULL) + low_high;
+        const uint64_t low = (middle << 32) | (low_low & 0xFFFFFFFFULL);
+        const uint64_t high = high_high + (high_low >> 32) + (middle >> 32);
+        return low ^ high;
+#endif
+    }
+
+    static inline uint64_t LoadWord(const char* bytes) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        word = __builtin_bswap64(word);
+#endif
+        return word;
+    }
+
+    static inline void Consume(uint64_t lanes[2], uint64_t word) {
+        lanes[0] = Mix(word ^ kSecrets[0], lanes[0] ^ kSecrets[1]);
+        lanes[1] = Mix(word ^ kSecrets[2], lanes[1] ^ kSecrets[3]);
+    }
+
+    inline void consume(uint64_t word) {
+        Consume(_lanes, word);
+    }
+};
+
+inline Fingerprint FingerprintOf(std::string_view bytes) {
+    Hasher hasher;
+    hasher.update(bytes);
+    return hasher.fingerprint();
+}
+
+inline uint64_t HashOf(std::string_view bytes) {
+    Hasher hasher;
+    hasher.update(bytes);
+    return hasher.hash();
+}
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_HASHING_H__
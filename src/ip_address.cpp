@@ -0,0 +1,145 @@
+#include "ip_address.h"
+
+#include "detail/ip_recognizers.h"
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+void AppendGroup(std::string& out, uint16_t group) {
+    bool leading = true;
+    for (int shift = 12; shift >= 0; shift -= 4) {
+        const uint8_t digit = static_cast<uint8_t>((group >> shift) & 0xF);
+        if (leading && digit == 0 && shift > 0) {
+            continue;
+        }
+        leading = false;
+        out.push_back(kHexDigits[digit]);
+    }
+}
+
+void AppendOctet(std::string& out, uint8_t octet) {
+    if (octet >= 100) {
+        out.push_back(static_cast<char>('0' + octet / 100));
+    }
+    if (octet >= 10) {
+        out.push_back(static_cast<char>('0' + (octet / 10) % 10));
+    }
+    out.push_back(static_cast<char>('0' + octet % 10));
+}
+
+bool IsIPv4Mapped(const uri::IPv6Address& address) {
+    // ::ffff:0:0/96, RFC5952 section 5.
+    for (size_t i = 0; i < 10; i++) {
+        if (address[i] != 0) {
+            return false;
+        }
+    }
+    return address[10] == 0xFF && address[11] == 0xFF;
+}
+
+} // namespace
+
+namespace uri {
+
+std::optional<IPv4Address> ParseIPv4Address(std::string_view input) {
+    __internal::IPv4Recognizer recognizer;
+    for (char c: input) {
+        if (!recognizer.feed(c)) {
+            return std::nullopt;
+        }
+    }
+
+    if (!recognizer.finish()) {
+        return std::nullopt;
+    }
+    return recognizer.value();
+}
+
+std::optional<uint16_t> ParsePortNumber(std::string_view input) {
+    if (input.empty()) {
+        return std::nullopt;
+    }
+
+    __internal::PortDecoder decoder;
+    for (char c: input) {
+        if (!decoder.feed(c)) {
+            return std::nullopt;
+        }
+    }
+    return decoder.value();
+}
+
+std::optional<IPv6Address> ParseIPv6Address(std::string_view input) {
+    __internal::IPv6Decoder decoder;
+    for (char c: input) {
+        if (!decoder.feed(c)) {
+            return std::nullopt;
+        }
+    }
+
+    IPv6Address address {};
+    if (!decoder.finish(address)) {
+        return std::nullopt;
+    }
+    return address;
+}
+
+std::string ToString(const IPv6Address& address) {
+    std::string out;
+    // "xxxx:" 8 times is the longest form.
+    out.reserve(40);
+
+    if (IsIPv4Mapped(address)) {
+        out.append("::ffff:");
+        for (size_t i = 12; i < 16; i++) {
+            if (i > 12) {
+                out.push_back('.');
+            }
+            AppendOctet(out, address[i]);
+        }
+        return out;
+    }
+
+    std::array<uint16_t, 8> groups {};
+    for (size_t i = 0; i < groups.size(); i++) {
+        groups[i] = static_cast<uint16_t>((address[2 * i] << 8) | address[2 * i + 1]);
+    }
+
+    // The first longest run of zero groups, a single zero group is kept.
+    size_t gap_begin = groups.size();
+    size_t gap_length = 1;
+    for (size_t i = 0; i < groups.size();) {
+        if (groups[i] != 0) {
+            i++;
+            continue;
+        }
+
+        size_t j = i;
+        while (j < groups.size() && groups[j] == 0) {
+            j++;
+        }
+        if (j - i > gap_length) {
+            gap_begin = i;
+            gap_length = j - i;
+        }
+        i = j;
+    }
+
+    for (size_t i = 0; i < groups.size(); i++) {
+        if (i == gap_begin) {
+            out.append("::");
+            i += gap_length - 1;
+            continue;
+        }
+
+        if (i > 0 && i != gap_begin + gap_length) {
+            out.push_back(':');
+        }
+        AppendGroup(out, groups[i]);
+    }
+
+    return out;
+}
+
+} // namespace uri
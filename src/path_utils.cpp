@@ -1,8 +1,10 @@
 #include "path_utils.h"
 
 #include <cstdint>
-#include <sstream>
-#include <stack>
+#include <cstring>
+#include <string_view>
+
+#include "pct_coding.h"
 
 namespace {
 
@@ -10,158 +12,69 @@ constexpr char kPathSeparator = '/';
 const std::string kPathThisSegment = ".";
 const std::string kPathRemoveSegment = "..";
 
-bool IsAlpha(char c) {
-    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
-}
-
-bool IsDigit(char c) {
-    return c >= '0' && c <= '9';
-}
-
-// The uppercase hexadecimal digits 'A' through 'F' are equivalent to
-// the lowercase digits 'a' through 'f', respectively.
-bool IsHexDigit(char c) {
-    return IsDigit(c) ||
-           (c >= 'a' && c <= 'f') ||
-           (c >= 'A' && c <= 'F');
-}
-
-bool IsSubDelims(char c) {
-    return (c == '!') || (c == '$') || (c == '&') || (c == '\'') ||
-           (c == '(') || (c == ')') || (c == '*') || (c == '+') ||
-           (c == ',') || (c == ';') || (c == '=');
-}
-
-bool IsGenDelims(char c) {
-    return (c == ':') || (c == '/') || (c == '?') || (c == '#') ||
-           (c == '[') || (c == ']') || (c == '@');
-}
-
-bool IsUnreservedSpecial(char c) {
-    return (c == '-') || (c == '.') ||
-           (c == '_') || (c == '~');
-}
-
-bool IsReserved(char c) {
-    return IsGenDelims(c) || IsSubDelims(c);
-}
-
-// Methods that verify whether
-// symbols should be decoded or encoded.
-bool ShouldDecode(uint16_t pct_encoded) {
-        // A-Z.
-    if ((pct_encoded >= 0x41 && pct_encoded <= 0x5A) ||
-        // a-z.
-        (pct_encoded >= 0x61 && pct_encoded <= 0x7A) ||
-        // 0-9.
-        (pct_encoded >= 0x30 && pct_encoded <= 0x39) ||
-        // Hyphen.
-        (pct_encoded == 0x2D) ||
-        // Period.
-        (pct_encoded == 0x2E) ||
-        // Underscore.
-        (pct_encoded == 0x5F) ||
-        // Tilde.
-        (pct_encoded == 0x7E)) {
-        return true;
-    }
-
-    return false;
-}
-
-bool ShouldEncode(char symbol) {
-    if (IsAlpha(symbol) ||
-        // Includes check for digits.
-        IsHexDigit(symbol) ||
-        IsUnreservedSpecial(symbol) ||
-        IsReserved(symbol)) {
-        return false;
-    }
-
-    return true;
-}
-
-uint8_t ConvertCharHexToDecim(char d) {
-    if (d >= '0' && d <= '9') {
-        return static_cast<uint8_t>(d - '0');
-    } else if (d == 'a' || d == 'A') {
-        return 10U;
-    } else if (d == 'b' || d == 'B') {
-        return 11U;
-    } else if (d == 'c' || d == 'C') {
-        return 12U;
-    } else if (d == 'd' || d == 'D') {
-        return 13U;
-    } else if (d == 'e' || d == 'E') {
-        return 14U;
-    } else if (d == 'f' || d == 'F') {
-        return 15U;
-    } else {
-        return 0U;
-    }
-}
-
-char ConvertHexToChar(uint16_t d) {
-    // d <= 0 has been implicity assumed.
-    if (d <= 9) {
-        return static_cast<char>(d + '0');
-    } else if (d == 10) {
-        return 'A';
-    } else if (d == 11) {
-        return 'B';
-    } else if (d == 12) {
-        return 'C';
-    } else if (d == 13) {
-        return 'D';
-    } else if (d == 14) {
-        return 'E';
-    } else if (d == 15) {
-        return 'F';
-    } else {
-        return '\0';
-    }
-}
-
-void DecodePct(uint16_t pct_encoded,
-            std::stringstream& out) {
-    out << static_cast<char>(pct_encoded);
-}
-
-void EncodePct(char c,
-               std::stringstream& out) {
-    uint16_t code = static_cast<uint16_t>(c);
-    out << '%' << ConvertHexToChar(code / 16) << ConvertHexToChar(code % 16);
-}
-
-std::string Code(const std::string& path) {
-    std::stringstream out;
+// Paths made only of these bytes and of triplets never grow when coded.
+constexpr uri::__internal::CharClassSet kPathCodedSet = uri::__internal::MakeCharClassSet(uri::__internal::kUnreserved | uri::__internal::kReserved);
+
+// Codes and removes dot segments of |path| in a single pass, see
+// RFC3986 section 5.2.4, and returns the length of the result.
+//
+// Segments are split, coded and removed the same way as the
+// SplitHierarchicalSegments, CodeIfNecessary and RemoveDotSegments
+// chain does, i.e. a trailing "/" is dropped and ".." never goes
+// above the first segment.
+//
+// The output is written to |out|, which must have room for the coded
+// path. |out| may be |path.data()| as long as nothing has to be encoded:
+// the output never gets ahead of the input then.
+size_t NormaliseTo(std::string_view path, char* out) {
+    using namespace uri::__internal;
+
+    size_t length = 0;
+    size_t segments = 0;
+
+    size_t begin = 0;
+    while (true) {
+        const size_t separator = path.find(kPathSeparator, begin);
+        const size_t end = (separator == std::string_view::npos) ? path.length() : separator;
+
+        // The trailing empty segment is dropped, unless it is the only one.
+        if (end == path.length() && end == begin && begin > 0) {
+            break;
+        }
 
-    size_t i = 0;
-    while (i < path.length()) {
-        if (path[i] == '%' &&
-            i < path.length() - 2 &&
-            IsHexDigit(path[i + 1]) &&
-            IsHexDigit(path[i + 2])) {
-            // PCT Encoded.
-            uint16_t pct_encoded = ConvertCharHexToDecim(path[i + 1]) * 16 + ConvertCharHexToDecim(path[i + 2]);
-            if (ShouldDecode(pct_encoded)) {
-                DecodePct(pct_encoded, out);
-            } else {
-                out << '%' << ConvertHexToChar(pct_encoded / 16) << ConvertHexToChar(pct_encoded % 16);
+        const size_t segment_start = length;
+        if (segments > 0) {
+            out[length++] = kPathSeparator;
+        }
+        const size_t value_start = length;
+        length = static_cast<size_t>(PctNormalise(path.substr(begin, end - begin), kPathCodingSet, out + length) - out);
+
+        // Dot segments are checked after coding, so "%2E" is a dot as well.
+        const std::string_view value(out + value_start, length - value_start);
+        if (value == kPathThisSegment) {
+            length = segment_start;
+        } else if (value == kPathRemoveSegment) {
+            length = segment_start;
+            if (segments > 0) {
+                segments--;
+                // Segments never contain separators, so the last one
+                // separates the popped segment from the previous one.
+                while (segments > 0 && out[length - 1] != kPathSeparator) {
+                    length--;
+                }
+                length = (segments > 0) ? length - 1 : 0;
             }
-            i += 3;
         } else {
-            char c = path[i];
-            if (ShouldEncode(c)) {
-                EncodePct(c, out);
-            } else {
-                out << c;
-            }
-            i += 1;
+            segments++;
+        }
+
+        if (end == path.length()) {
+            break;
         }
+        begin = end + 1;
     }
 
-    return out.str();
+    return length;
 }
 
 } // namespace
@@ -198,58 +111,117 @@ std::vector<std::string> SplitHierarchicalSegments(const std::string& path) {
 }
 
 std::vector<std::string> RemoveDotSegments(const std::vector<std::string>& segments) {
-    std::stack<std::string> segments_stack;
     std::vector<std::string> normalised_segments;
+    normalised_segments.reserve(segments.size());
 
     for (const auto& segment: segments) {
         if (segment == kPathThisSegment) {
             continue;
         } else if (segment == kPathRemoveSegment) {
-            if (!segments_stack.empty()) {
-                segments_stack.pop();
+            if (!normalised_segments.empty()) {
+                normalised_segments.pop_back();
             }
         } else {
-            segments_stack.push(segment);
+            normalised_segments.push_back(segment);
         }
     }
 
-    std::stack<std::string> reversed_segments_stack;
-    while (!segments_stack.empty()) {
-        reversed_segments_stack.push(segments_stack.top());
-        segments_stack.pop();
+    if (segments.size() > 0 && normalised_segments.empty()) {
+        normalised_segments.emplace_back("");
     }
 
-    while (!reversed_segments_stack.empty()) {
-        normalised_segments.emplace_back(reversed_segments_stack.top());
-        reversed_segments_stack.pop();
+    return normalised_segments;
+}
+
+char* RemoveDotSegments(std::string_view path, char* out) {
+    return RemoveDotSegments(path, out, out);
+}
+
+char* RemoveDotSegments(std::string_view path, char* begin, char* out) {
+    // Removes the last segment and its preceding "/", if any.
+    const auto pop = [begin, &out]() {
+        while (out > begin && *(out - 1) != kPathSeparator) {
+            out--;
+        }
+        if (out > begin) {
+            out--;
+        }
+    };
+
+    // Nothing is written ahead of the input that has been read.
+    size_t i = 0;
+    while (i < path.length()) {
+        const std::string_view input = path.substr(i);
+
+        if (input.compare(0, 3, "../") == 0) {
+            i += 3;
+        } else if (input.compare(0, 2, "./") == 0) {
+            i += 2;
+        } else if (input.compare(0, 3, "/./") == 0) {
+            i += 2;
+        } else if (input == "/.") {
+            *out++ = kPathSeparator;
+            break;
+        } else if (input.compare(0, 4, "/../") == 0) {
+            i += 3;
+            pop();
+        } else if (input == "/..") {
+            pop();
+            *out++ = kPathSeparator;
+            break;
+        } else if (input == kPathThisSegment || input == kPathRemoveSegment) {
+            break;
+        } else {
+            // Moves the first segment with its leading "/", if any.
+            const size_t separator = input.find(kPathSeparator, 1);
+            const size_t length = (separator == std::string_view::npos) ? input.length() : separator;
+            std::memmove(out, input.data(), length);
+            out += length;
+            i += length;
+        }
     }
 
-    if (segments.size() > 0 && normalised_segments.empty()) {
-        normalised_segments.emplace_back("");
+    return out;
+}
+
+bool HasDotSegments(std::string_view path) {
+    for (size_t i = path.find('.'); i != std::string_view::npos; i = path.find('.', i + 1)) {
+        if (i > 0 && path[i - 1] != kPathSeparator) {
+            continue;
+        }
+
+        size_t end = i + 1;
+        if (end < path.length() && path[end] == '.') {
+            end++;
+        }
+        if (end == path.length() || path[end] == kPathSeparator) {
+            return true;
+        }
     }
 
-    return normalised_segments;
+    return false;
 }
 
 std::string CodeIfNecessary(const std::string& path) {
-    return Code(path);
+    std::string out;
+    __internal::AppendPctNormalised(path, __internal::kPathCodingSet, out);
+    return out;
 }
 
 std::string Normalise(const std::string& path) {
-    std::string coded_path = CodeIfNecessary(path);
-    std::vector<std::string> segments = SplitHierarchicalSegments(coded_path);
-    std::vector<std::string> normalised_segments = RemoveDotSegments(segments);
-
-    std::stringstream out;
-    for (size_t i = 0; i < normalised_segments.size(); i++) {
-        out << normalised_segments[i];
+    std::string out(__internal::PctNormalisedLength(path, __internal::kPathCodingSet), '\0');
+    out.resize(NormaliseTo(path, out.data()));
+    return out;
+}
 
-        if (i < normalised_segments.size() - 1) {
-            out << kPathSeparator;
-        }
+void NormaliseInPlace(std::string& path) {
+    // Coding may grow the path, then there is no room to do it in place.
+    if (__internal::ScanCharClass(path, kPathCodedSet) < path.length()) {
+        path = Normalise(path);
+        return;
     }
 
-    return out.str();
+    path.resize(NormaliseTo(path, path.data()));
 }
 
 } // namespace path
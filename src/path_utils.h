@@ -2,6 +2,7 @@
 #define __URIC_PATH_NORMALISER_H__
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace uri {
@@ -12,7 +13,22 @@ std::vector<std::string> SplitHierarchicalSegments(const std::string& path);
 std::string CodeIfNecessary(const std::string& path);
 std::vector<std::string> RemoveDotSegments(const std::vector<std::string>& segments);
 
+// remove_dot_segments of RFC3986 section 5.2.4 as it is written,
+// i.e. trailing "/" are kept. Writes the result to |out| and returns
+// the end of it, the result is never longer than |path|, so |out|
+// may be |path.data()|.
+char* RemoveDotSegments(std::string_view path, char* out);
+// Same as above, but appends the result to the output that starts at
+// |begin| and ends at |out|, ".." removes segments of the output as well.
+// E.g. merged paths are resolved after the dot-free base directory.
+char* RemoveDotSegments(std::string_view path, char* begin, char* out);
+// Whether any segment of |path| is "." or "..".
+bool HasDotSegments(std::string_view path);
+
+// Removes dot segments and codes the path in one pass.
 std::string Normalise(const std::string& path);
+// Same as above, but reuses the buffer of |path|.
+void NormaliseInPlace(std::string& path);
 
 } // namespace path
 
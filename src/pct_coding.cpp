@@ -0,0 +1,300 @@
+#include "pct_coding.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define URIC_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using uri::__internal::CharClassSet;
+using uri::__internal::HasCharClass;
+using uri::__internal::HexDigitValue;
+using uri::__internal::ScanCharClass;
+using uri::__internal::kHexDigit;
+using uri::__internal::kUpperHexDigits;
+
+constexpr char kPercent = '%';
+
+// Whether a valid triplet starts at |i|, the percent sign included.
+inline bool IsPctEncodedAt(std::string_view text, size_t i) {
+    return i + 2 < text.length() &&
+           text[i] == kPercent &&
+           HasCharClass(text[i + 1], kHexDigit) &&
+           HasCharClass(text[i + 2], kHexDigit);
+}
+
+inline char DecodeTripletAt(std::string_view text, size_t i) {
+    return static_cast<char>((HexDigitValue(text[i + 1]) << 4) | HexDigitValue(text[i + 2]));
+}
+
+inline char* WriteTriplet(uint8_t value, char* out) {
+    out[0] = kPercent;
+    out[1] = kUpperHexDigits[value >> 4];
+    out[2] = kUpperHexDigits[value & 0x0F];
+    return out + 3;
+}
+
+// |out| may overlap |text| when it is not ahead of it.
+inline char* Copy(std::string_view text, size_t from, size_t to, char* out) {
+    if (to > from) {
+        std::memmove(out, text.data() + from, to - from);
+    }
+    return out + (to - from);
+}
+
+// Offset of the next "%" starting from |i|, or the length of the text.
+inline size_t FindPercent(std::string_view text, size_t i) {
+    if (i >= text.length()) {
+        return text.length();
+    }
+
+    // Triplets often come in runs, no need to call memchr for those.
+    if (text[i] == kPercent) {
+        return i;
+    }
+
+    const void* percent = std::memchr(text.data() + i, kPercent, text.length() - i);
+    return percent == nullptr ? text.length() : static_cast<size_t>(static_cast<const char*>(percent) - text.data());
+}
+
+// Decodes the run of triplets starting at |i| and returns the offset after it,
+// the scalar version decodes nothing and leaves the run to the caller.
+using decode_run_function_t = size_t (*)(std::string_view text, size_t i, char*& out);
+
+size_t DecodeRunScalar(std::string_view, size_t i, char*&) {
+    return i;
+}
+
+#if defined(URIC_X86_KERNELS)
+
+// Five triplets fit into a 16 bytes block: "%" at 0, 3, 6, 9 and 12,
+// HEXDIG at the other offsets but the last one.
+constexpr uint32_t kPercentsMask = 0x1249;
+constexpr uint32_t kHexDigitsMask = 0x6DB6;
+constexpr size_t kTripletsPerBlock = 5;
+
+__attribute__((target("ssse3")))
+size_t DecodeRunSsse3(std::string_view text, size_t i, char*& out) {
+    const __m128i percent = _mm_set1_epi8(kPercent);
+    const __m128i lower_case = _mm_set1_epi8(0x20);
+    const __m128i high_nibbles = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i low_nibbles = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    while (i + 16 <= text.length()) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+
+        const uint32_t percents = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, percent)));
+        if ((percents & kPercentsMask) != kPercentsMask) {
+            break;
+        }
+
+        // Non-ASCII bytes are negative and fail both ranges.
+        const __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                             _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), bytes));
+        const __m128i lower = _mm_or_si128(bytes, lower_case);
+        const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                              _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+        const uint32_t hex_digits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(digits, letters)));
+        if ((hex_digits & kHexDigitsMask) != kHexDigitsMask) {
+            break;
+        }
+
+        const __m128i values = _mm_or_si128(
+            _mm_and_si128(digits, _mm_sub_epi8(bytes, _mm_set1_epi8('0'))),
+            _mm_and_si128(letters, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+        // Nibbles are below 16, shifting 16-bit lanes keeps them within their bytes.
+        const __m128i decoded = _mm_or_si128(_mm_slli_epi16(_mm_shuffle_epi8(values, high_nibbles), 4),
+                                             _mm_shuffle_epi8(values, low_nibbles));
+
+        alignas(16) char block[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(block), decoded);
+        std::memcpy(out, block, kTripletsPerBlock);
+
+        out += kTripletsPerBlock;
+        i += 3 * kTripletsPerBlock;
+    }
+
+    return i;
+}
+
+decode_run_function_t SelectDecodeRunFunction() {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("ssse3")) {
+        return DecodeRunSsse3;
+    }
+
+    return DecodeRunScalar;
+}
+
+#endif // URIC_X86_KERNELS
+
+decode_run_function_t GetDecodeRunFunction() {
+#if defined(URIC_X86_KERNELS)
+    static const decode_run_function_t decode_run_function = SelectDecodeRunFunction();
+    return decode_run_function;
+#else
+    return DecodeRunScalar;
+#endif
+}
+
+} // namespace
+
+namespace uri {
+
+namespace __internal {
+
+size_t PctEncodedLength(std::string_view text, const CharClassSet& allowed) {
+    size_t length = text.length();
+
+    size_t i = 0;
+    while (true) {
+        i += ScanCharClass(text.substr(i), allowed);
+        if (i >= text.length()) {
+            break;
+        }
+
+        length += 2;
+        i += 1;
+    }
+
+    return length;
+}
+
+char* PctEncode(std::string_view text, const CharClassSet& allowed, char* out) {
+    size_t i = 0;
+    while (true) {
+        const size_t stop = i + ScanCharClass(text.substr(i), allowed);
+        out = Copy(text, i, stop, out);
+        if (stop >= text.length()) {
+            break;
+        }
+
+        out = WriteTriplet(static_cast<uint8_t>(text[stop]), out);
+        i = stop + 1;
+    }
+
+    return out;
+}
+
+size_t PctDecodedLength(std::string_view text) {
+    size_t length = text.length();
+
+    size_t i = FindPercent(text, 0);
+    while (i < text.length()) {
+        if (IsPctEncodedAt(text, i)) {
+            length -= 2;
+            i += 3;
+        } else {
+            i += 1;
+        }
+        i = FindPercent(text, i);
+    }
+
+    return length;
+}
+
+char* PctDecode(std::string_view text, char* out) {
+    const decode_run_function_t decode_run = GetDecodeRunFunction();
+
+    size_t i = 0;
+    while (i < text.length()) {
+        const size_t stop = FindPercent(text, i);
+        out = Copy(text, i, stop, out);
+        i = stop;
+        if (i >= text.length()) {
+            break;
+        }
+
+        if (!IsPctEncodedAt(text, i)) {
+            *out++ = kPercent;
+            i += 1;
+            continue;
+        }
+
+        i = decode_run(text, i, out);
+        // The tail of the run, or a run too short for a block.
+        if (IsPctEncodedAt(text, i)) {
+            *out++ = DecodeTripletAt(text, i);
+            i += 3;
+        }
+    }
+
+    return out;
+}
+
+size_t PctNormalisedLength(std::string_view text, const CharClassSet& allowed) {
+    size_t length = text.length();
+
+    size_t i = 0;
+    while (true) {
+        i += ScanCharClass(text.substr(i), allowed);
+        if (i >= text.length()) {
+            break;
+        }
+
+        if (IsPctEncodedAt(text, i)) {
+            if (HasCharClass(DecodeTripletAt(text, i), kUnreserved)) {
+                length -= 2;
+            }
+            i += 3;
+        } else {
+            length += 2;
+            i += 1;
+        }
+    }
+
+    return length;
+}
+
+char* PctNormalise(std::string_view text, const CharClassSet& allowed, char* out) {
+    size_t i = 0;
+    while (true) {
+        const size_t stop = i + ScanCharClass(text.substr(i), allowed);
+        out = Copy(text, i, stop, out);
+        if (stop >= text.length()) {
+            break;
+        }
+
+        if (IsPctEncodedAt(text, stop)) {
+            const char decoded = DecodeTripletAt(text, stop);
+            if (HasCharClass(decoded, kUnreserved)) {
+                *out++ = decoded;
+            } else {
+                out = WriteTriplet(static_cast<uint8_t>(decoded), out);
+            }
+            i = stop + 3;
+        } else {
+            out = WriteTriplet(static_cast<uint8_t>(text[stop]), out);
+            i = stop + 1;
+        }
+    }
+
+    return out;
+}
+
+bool IsPctNormalised(std::string_view text, const CharClassSet& allowed) {
+    size_t i = 0;
+    while (true) {
+        i += ScanCharClass(text.substr(i), allowed);
+        if (i >= text.length()) {
+            return true;
+        }
+
+        // Bytes outside of |allowed| are encoded, triplets with lowercase
+        // digits are uppercased, unreserved characters are decoded.
+        if (!IsPctEncodedAt(text, i) ||
+            (text[i + 1] >= 'a') || (text[i + 2] >= 'a') ||
+            HasCharClass(DecodeTripletAt(text, i), kUnreserved)) {
+            return false;
+        }
+        i += 3;
+    }
+}
+
+} // namespace __internal
+
+} // namespace uri
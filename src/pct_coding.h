@@ -0,0 +1,66 @@
+#ifndef __URIC_PCT_CODING_H__
+#define __URIC_PCT_CODING_H__
+
+#include <cstddef>
+#include <string_view>
+
+#include "detail/char_classes.h"
+#include "detail/char_scanner.h"
+
+namespace uri {
+
+namespace __internal {
+
+// Percent-encoding kernels.
+//
+// Every kernel comes in two parts: the first one computes the exact
+// length of the output, the second one writes exactly that many bytes,
+// so the output is allocated once. Stretches of bytes that stay as they
+// are get found with ScanCharClass and copied as blocks.
+// |allowed| sets should not accept percent-encoded triplets,
+// see MakeCharClassSet.
+
+// The hexadecimal value of a HEXDIG.
+constexpr uint8_t HexDigitValue(char c) {
+    // Letters of both cases have 0x40 set and a low nibble of 1-6.
+    return static_cast<uint8_t>((c & 0x0F) + 9 * ((c >> 6) & 1));
+}
+
+inline constexpr char kUpperHexDigits[] = "0123456789ABCDEF";
+
+// Percent-encodes every byte outside of |allowed|, including "%".
+size_t PctEncodedLength(std::string_view text, const CharClassSet& allowed);
+char* PctEncode(std::string_view text, const CharClassSet& allowed, char* out);
+
+// Decodes every percent-encoded triplet, a "%" that does not start
+// a triplet is kept as it is. Runs of triplets are decoded with
+// SSSE3 when the CPU supports it.
+size_t PctDecodedLength(std::string_view text);
+char* PctDecode(std::string_view text, char* out);
+
+// Percent-encoding normalisation of RFC3986, see sections 6.2.2.1
+// and 6.2.2.2: triplets of unreserved characters are decoded, other
+// triplets are uppercased, bytes outside of |allowed| are encoded.
+// |out| may be |text.data()| when there is nothing to encode.
+size_t PctNormalisedLength(std::string_view text, const CharClassSet& allowed);
+char* PctNormalise(std::string_view text, const CharClassSet& allowed, char* out);
+
+// Whether PctNormalise would keep |text| as it is.
+bool IsPctNormalised(std::string_view text, const CharClassSet& allowed);
+
+// Appends the normalised |text| to |out|, which is resized once.
+template<typename String>
+void AppendPctNormalised(std::string_view text, const CharClassSet& allowed, String& out) {
+    const size_t offset = out.length();
+    out.resize(offset + PctNormalisedLength(text, allowed));
+    PctNormalise(text, allowed, out.data() + offset);
+}
+
+// Bytes that paths keep during normalisation, see path::CodeIfNecessary.
+inline constexpr CharClassSet kPathCodingSet = MakeCharClassSet(kUnreserved | kReserved, /* pct_encoded= */ false);
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_PCT_CODING_H__
@@ -0,0 +1,59 @@
+#include "pct_encoding.h"
+
+#include "detail/char_classes.h"
+#include "detail/char_scanner.h"
+#include "pct_coding.h"
+
+namespace {
+
+using uri::EncodeSet;
+using uri::__internal::CharClassSet;
+using uri::__internal::MakeCharClassSet;
+
+template<EncodeSet kSet>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass = 0;
+
+template<>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass<EncodeSet::kUserInfo> = uri::__internal::kUserInfo;
+template<>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass<EncodeSet::kHost> = uri::__internal::kRegName;
+template<>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass<EncodeSet::kPath> = uri::__internal::kPath;
+template<>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass<EncodeSet::kSegment> = uri::__internal::kPchar;
+template<>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass<EncodeSet::kQuery> = uri::__internal::kQueryFragment;
+template<>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass<EncodeSet::kQueryParam> = uri::__internal::kQueryParam;
+template<>
+constexpr uri::__internal::char_class_t kEncodeSetCharClass<EncodeSet::kFragment> = uri::__internal::kQueryFragment;
+
+template<EncodeSet kSet>
+constexpr CharClassSet kEncodeCharClassSet = MakeCharClassSet(kEncodeSetCharClass<kSet>, /* pct_encoded= */ false);
+
+} // namespace
+
+namespace uri {
+
+template<EncodeSet kSet>
+std::string encode(std::string_view input) {
+    std::string out(__internal::PctEncodedLength(input, kEncodeCharClassSet<kSet>), '\0');
+    __internal::PctEncode(input, kEncodeCharClassSet<kSet>, out.data());
+    return out;
+}
+
+template std::string encode<EncodeSet::kUserInfo>(std::string_view input);
+template std::string encode<EncodeSet::kHost>(std::string_view input);
+template std::string encode<EncodeSet::kPath>(std::string_view input);
+template std::string encode<EncodeSet::kSegment>(std::string_view input);
+template std::string encode<EncodeSet::kQuery>(std::string_view input);
+template std::string encode<EncodeSet::kQueryParam>(std::string_view input);
+template std::string encode<EncodeSet::kFragment>(std::string_view input);
+
+std::string decode(std::string_view input) {
+    std::string out(__internal::PctDecodedLength(input), '\0');
+    __internal::PctDecode(input, out.data());
+    return out;
+}
+
+} // namespace uri
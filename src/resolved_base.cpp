@@ -0,0 +1,273 @@
+#include "resolved_base.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "path_utils.h"
+#include "scratch_buffer.h"
+
+namespace {
+
+constexpr char kPathSeparator = '/';
+constexpr std::string_view kRootPath = "/";
+// Keeps a path that starts with "//" from being taken for an authority.
+constexpr std::string_view kPathGuard = "/.";
+
+// Resolved paths of common references fit on the stack.
+using PathBuffer = uri::__internal::ScratchBuffer<512>;
+
+// The part of the base path the references are merged with, see section 5.2.3.
+std::string_view DirectoryOf(const uri::UriView& base, std::string_view base_path) {
+    if (base.getAuthority() && base_path.empty()) {
+        return kRootPath;
+    }
+
+    const size_t separator = base_path.rfind(kPathSeparator);
+    return (separator == std::string_view::npos) ? std::string_view() : base_path.substr(0, separator + 1);
+}
+
+// Transform References of section 5.2.2, with |base_path| already cleared
+// of dot segments. The target path is written to |buffer|, unless
+// the reference path can be taken as it is.
+std::string_view ResolvePath(const uri::UriView& base,
+                             std::string_view base_path,
+                             const uri::UriView& reference,
+                             bool merge,
+                             char* buffer) {
+    using uri::path::RemoveDotSegments;
+
+    const std::string_view path = reference.getPath();
+    if (!merge) {
+        if (!uri::path::HasDotSegments(path)) {
+            return path;
+        }
+        return std::string_view(buffer, static_cast<size_t>(RemoveDotSegments(path, buffer) - buffer));
+    }
+
+    const std::string_view directory = DirectoryOf(base, base_path);
+    if (directory.empty()) {
+        return std::string_view(buffer, static_cast<size_t>(RemoveDotSegments(path, buffer) - buffer));
+    }
+
+    // The directory is free of dot segments and ends with "/", so removing
+    // dot segments of the merged path leaves it as it is up to that "/".
+    std::memcpy(buffer, directory.data(), directory.length());
+    std::memcpy(buffer + directory.length(), path.data(), path.length());
+
+    char* out = buffer + directory.length() - 1;
+    const std::string_view rest(out, path.length() + 1);
+    return std::string_view(buffer, static_cast<size_t>(RemoveDotSegments(rest, buffer, out) - buffer));
+}
+
+uri::Uri Resolve(const uri::UriView& base,
+                 std::string_view base_path,
+                 const uri::UriView& reference,
+                 const uri::Uri::allocator_type& allocator) {
+    const std::string_view reference_path = reference.getPath();
+
+    if (!reference.getScheme() && !reference.getAuthority() && reference_path.empty()) {
+        return uri::Uri(uri::UriView(base.getScheme(),
+                                     base.getAuthority(),
+                                     base_path,
+                                     reference.getQuery() ? reference.getQuery() : base.getQuery(),
+                                     reference.getFragment()),
+                        allocator);
+    }
+
+    const bool own_components = reference.getScheme() || reference.getAuthority();
+    const bool merge = !own_components && reference_path.front() != kPathSeparator;
+    const auto& authority = own_components ? reference.getAuthority() : base.getAuthority();
+
+    PathBuffer buffer(kPathGuard.length() + DirectoryOf(base, base_path).length() + reference_path.length());
+    std::string_view path = ResolvePath(base, base_path, reference, merge, buffer.data() + kPathGuard.length());
+
+    if (!authority && path.substr(0, 2) == "//") {
+        std::memcpy(buffer.data(), kPathGuard.data(), kPathGuard.length());
+        path = std::string_view(buffer.data(), kPathGuard.length() + path.length());
+    }
+
+    return uri::Uri(uri::UriView(reference.getScheme() ? reference.getScheme() : base.getScheme(),
+                                 authority,
+                                 path,
+                                 reference.getQuery(),
+                                 reference.getFragment()),
+                    allocator);
+}
+
+// Writes the relative path from |directory| to |path| to |buffer| and
+// returns its length. Both have to be rooted, or the directory has to be
+// empty and the path rootless, see Relativize.
+size_t RelativePath(std::string_view directory, std::string_view path, char* buffer) {
+    // The segments both have in common, i.e. the longest
+    // common prefix that ends with "/".
+    size_t common = 0;
+    const size_t length = std::min(directory.length(), path.length());
+    for (size_t i = 0; i < length && directory[i] == path[i]; i++) {
+        if (directory[i] == kPathSeparator) {
+            common = i + 1;
+        }
+    }
+
+    char* out = buffer;
+    for (size_t i = common; i < directory.length(); i++) {
+        if (directory[i] == kPathSeparator) {
+            std::memcpy(out, "../", 3);
+            out += 3;
+        }
+    }
+
+    const std::string_view rest = path.substr(common);
+    if (rest.empty()) {
+        // "." stands for the directory itself, ".." for the one above.
+        if (out == buffer) {
+            *out++ = '.';
+        } else {
+            out--;
+        }
+        return static_cast<size_t>(out - buffer);
+    }
+
+    // A leading "/" would make the path absolute, a ":" in the first
+    // segment would make it a scheme.
+    if (out == buffer && (rest.front() == kPathSeparator || rest.substr(0, rest.find(kPathSeparator)).find(':') != std::string_view::npos)) {
+        std::memcpy(out, "./", 2);
+        out += 2;
+    }
+
+    std::memcpy(out, rest.data(), rest.length());
+    return static_cast<size_t>(out - buffer) + rest.length();
+}
+
+// The shortest reference that Resolve turns into |target|, |base_path|
+// is already cleared of dot segments.
+std::optional<uri::Uri> Relativize(const uri::UriView& base,
+                                   std::string_view base_path,
+                                   const uri::UriView& target,
+                                   const uri::Uri::allocator_type& allocator) {
+    using uri::Uri;
+    using uri::UriView;
+
+    if (!target.getScheme()) {
+        return std::nullopt;
+    }
+
+    if (target.getScheme() != base.getScheme()) {
+        return Uri(target, allocator);
+    }
+
+    if (target.getAuthority() != base.getAuthority()) {
+        if (!target.getAuthority()) {
+            return Uri(target, allocator);
+        }
+        // Network-path reference.
+        return Uri(UriView(std::nullopt, target.getAuthority(), target.getPath(), target.getQuery(), target.getFragment()), allocator);
+    }
+
+    // Resolved paths never have dot segments.
+    std::string_view path = target.getPath();
+    PathBuffer target_path(path.length());
+    if (uri::path::HasDotSegments(path)) {
+        char* end = uri::path::RemoveDotSegments(path, target_path.data());
+        path = std::string_view(target_path.data(), static_cast<size_t>(end - target_path.data()));
+    }
+
+    // Same-document and query-only references.
+    if (path == base_path) {
+        if (target.getQuery() == base.getQuery()) {
+            return Uri(UriView(std::nullopt, std::nullopt, "", std::nullopt, target.getFragment()), allocator);
+        }
+        if (target.getQuery()) {
+            return Uri(UriView(std::nullopt, std::nullopt, "", target.getQuery(), target.getFragment()), allocator);
+        }
+    }
+
+    const bool rooted = !path.empty() && path.front() == kPathSeparator;
+    // "//" would start an authority.
+    const bool absolute = rooted && path.substr(0, 2) != "//";
+
+    const std::string_view directory = DirectoryOf(base, base_path);
+    const bool relative = directory.empty() ? !rooted : (rooted && directory.front() == kPathSeparator);
+
+    PathBuffer buffer(3 * directory.length() + 2 + path.length());
+    std::string_view reference_path;
+    if (relative) {
+        reference_path = std::string_view(buffer.data(), RelativePath(directory, path, buffer.data()));
+    }
+    if (absolute && (!relative || path.length() < reference_path.length())) {
+        reference_path = path;
+    }
+
+    if (!relative && !absolute) {
+        if (!target.getAuthority()) {
+            return Uri(target, allocator);
+        }
+        return Uri(UriView(std::nullopt, target.getAuthority(), path, target.getQuery(), target.getFragment()), allocator);
+    }
+
+    return Uri(UriView(std::nullopt, std::nullopt, reference_path, target.getQuery(), target.getFragment()), allocator);
+}
+
+} // namespace
+
+namespace uri {
+
+ResolvedBase::ResolvedBase(const Uri& base, const allocator_type& allocator) noexcept:
+    _base(base, allocator),
+    _path(base.getPath(), allocator) {
+    _path.resize(static_cast<size_t>(path::RemoveDotSegments(_path, _path.data()) - _path.data()));
+
+    if (!base.getAuthority() && std::string_view(_path).substr(0, 2) == "//") {
+        _path.insert(0, kPathGuard);
+    }
+}
+
+std::optional<ResolvedBase> ResolvedBase::from(const Uri& base,
+                                               const allocator_type& allocator) {
+    if (!base.getScheme()) {
+        return std::nullopt;
+    }
+
+    return ResolvedBase(base, allocator);
+}
+
+std::optional<ResolvedBase> ResolvedBase::parse(std::string_view base,
+                                                const allocator_type& allocator) {
+    const auto uri = Uri::parse(base, allocator);
+    if (!uri) {
+        return std::nullopt;
+    }
+
+    return from(uri.value(), allocator);
+}
+
+std::optional<Uri> ResolvedBase::resolve(std::string_view reference,
+                                         const allocator_type& allocator) const {
+    const auto view = UriView::tryParse(reference);
+    if (!view) {
+        return std::nullopt;
+    }
+
+    return resolve(view.value(), allocator);
+}
+
+Uri ResolvedBase::resolve(const UriView& reference,
+                          const allocator_type& allocator) const {
+    return Resolve(_base.toView(), _path, reference, allocator);
+}
+
+Uri ResolvedBase::resolve(const Uri& reference,
+                          const allocator_type& allocator) const {
+    return resolve(reference.toView(), allocator);
+}
+
+std::optional<Uri> ResolvedBase::relativize(const UriView& target,
+                                            const allocator_type& allocator) const {
+    return Relativize(_base.toView(), _path, target, allocator);
+}
+
+std::optional<Uri> ResolvedBase::relativize(const Uri& target,
+                                            const allocator_type& allocator) const {
+    return relativize(target.toView(), allocator);
+}
+
+} // namespace uri
@@ -0,0 +1,38 @@
+#ifndef __URIC_SCRATCH_BUFFER_H__
+#define __URIC_SCRATCH_BUFFER_H__
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace uri {
+
+namespace __internal {
+
+// Temporary space of a known size: common sizes fit on the stack,
+// larger ones are allocated for the lifetime of the buffer.
+template<size_t kStackCapacity>
+class ScratchBuffer {
+public:
+    explicit ScratchBuffer(size_t capacity):
+        _heap(capacity > kStackCapacity ? capacity : 0, '\0') {
+        // Empty on purpose.
+    }
+
+    ScratchBuffer(const ScratchBuffer& that) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer& that) = delete;
+
+    inline char* data() {
+        return _heap.empty() ? _stack.data() : _heap.data();
+    }
+
+private:
+    std::array<char, kStackCapacity> _stack;
+    std::string _heap;
+};
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_SCRATCH_BUFFER_H__
@@ -1,8 +1,9 @@
 #ifndef __URIC_TOKEN_READER_H__
 #define __URIC_TOKEN_READER_H__
 
+#include <algorithm>
 #include <cstdint>
-#include <string>
+#include <string_view>
 
 namespace uri {
 
@@ -14,47 +15,29 @@ class TokenReader {
 
     static inline constexpr char TOKEN_EOF = 0;
 
-    explicit TokenReader(const std::string& raw_text):
+    // The reader does not own the text,
+    // therefore the text should outlive the reader
+    // and every view extracted from it.
+    explicit TokenReader(std::string_view raw_text) noexcept:
         _index(0),
         _raw_text(raw_text) {
         // Empty on purpose.
     }
 
-    TokenReader(const TokenReader& that) {
-        this->_index = that._index;
-        this->_raw_text = that._raw_text;
-    }
-
-    TokenReader& operator=(const TokenReader& that) {
-        if (this != &that) {
-            this->_index = that._index;
-            this->_raw_text = that._raw_text;
-        }
-
-        return *this;
-    }
-
-    TokenReader(TokenReader&& that) noexcept {
-        this->_index = that._index;
-        this->_raw_text = std::move(that._raw_text);
-    }
+    TokenReader(const TokenReader& that) noexcept = default;
+    TokenReader& operator=(const TokenReader& that) noexcept = default;
+    TokenReader(TokenReader&& that) noexcept = default;
+    TokenReader& operator=(TokenReader&& that) noexcept = default;
 
-    TokenReader& operator=(TokenReader&& that) noexcept {
-        if (this != &that) {
-            this->_index = that._index;
-            this->_raw_text = std::move(that._raw_text);
-        }
-
-        return *this;
-    }
-
-    std::string extract(token_t start) const {
+    // Returned views point into the reader's text, empty views
+    // still keep their position within the text.
+    std::string_view extract(token_t start) const {
         return extract(start, /* end= */ save());
     }
 
-    std::string extract(token_t start, token_t end) const {
+    std::string_view extract(token_t start, token_t end) const {
         if (end > _raw_text.length() || end <= start) {
-            return "";
+            return _raw_text.substr(std::min(start, _raw_text.length()), 0);
         }
 
         return _raw_text.substr(start, end - start);
@@ -68,6 +51,15 @@ class TokenReader {
         _index = token;
     }
 
+    // Unread part of the text.
+    inline std::string_view remaining() const {
+        return _raw_text.substr(_index);
+    }
+
+    void skip(size_t count) {
+        _index = std::min(_index + count, _raw_text.length());
+    }
+
     inline bool hasNext() const {
         return _index < _raw_text.length();
     }
@@ -91,7 +83,7 @@ class TokenReader {
         return false;
     }
 
-    bool consumeAll(const std::string& match) {
+    bool consumeAll(std::string_view match) {
         for (size_t i = 0; i < match.length(); i++) {
             if (!consume(match[i])) {
                 return false;
@@ -112,7 +104,7 @@ class TokenReader {
     ~TokenReader() = default;
   private:
     size_t _index;
-    std::string _raw_text;
+    std::string_view _raw_text;
 };
 
 } // namespace __internal
@@ -1,50 +1,406 @@
 #include "uri.h"
 
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "hashing.h"
+#include "ip_address.h"
+#include "detail/ip_recognizers.h"
 #include "path_utils.h"
+#include "pct_coding.h"
+#include "resolved_base.h"
+#include "detail/scheme_recognizer.h"
+#include "scratch_buffer.h"
 #include "token_reader.h"
 #include "uri_parser.h"
+#include "detail/uri_state_machine.h"
+
+namespace {
+
+uri::HostType HostTypeOf(std::string_view host, bool is_host_ip_literal) {
+    if (is_host_ip_literal) {
+        return uri::HostType::kIPLiteral;
+    }
+
+    uri::__internal::IPv4Recognizer ipv4;
+    for (char c: host) {
+        if (!ipv4.feed(c)) {
+            return uri::HostType::kRegName;
+        }
+    }
+    return ipv4.finish() ? uri::HostType::kIPv4 : uri::HostType::kRegName;
+}
+
+inline char ToLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Schemes that define a default port and "/" as the empty path, see section 6.2.3.
+std::optional<uint16_t> DefaultPortOf(uri::SchemeId scheme) {
+    switch (scheme) {
+        case uri::SchemeId::kHttp:
+        case uri::SchemeId::kWs:
+            return 80;
+        case uri::SchemeId::kHttps:
+        case uri::SchemeId::kWss:
+            return 443;
+        case uri::SchemeId::kFtp:
+            return 21;
+        default:
+            return std::nullopt;
+    }
+}
+
+// Hexadecimal digits of triplets stay uppercase.
+void LowercaseHost(char* begin, char* end) {
+    while (begin < end) {
+        if (*begin == '%') {
+            begin += 3;
+            continue;
+        }
+        *begin = ToLower(*begin);
+        begin++;
+    }
+}
+
+// Dot segments of relative paths are meaningful until the
+// reference is resolved.
+inline bool HasRemovableDotSegments(const optional_string_view_t& scheme, std::string_view path) {
+    return scheme || (!path.empty() && path.front() == '/');
+}
+
+inline bool IsDefaultPort(std::string_view port, const std::optional<uint16_t>& default_port) {
+    return default_port && uri::ParsePortNumber(port) == default_port;
+}
+
+// Length of the URI serialised from the raw parts, see Uri::fromParts.
+size_t SerialisedLengthOf(std::string_view raw_path,
+                          const optional_string_view_t& raw_scheme,
+                          const optional_string_view_t& raw_authority,
+                          const optional_string_view_t& raw_query,
+                          const optional_string_view_t& raw_fragment) {
+    // scheme ":" "//" authority path "?" query "#" fragment
+    const auto length = [](const optional_string_view_t& value, size_t separators) {
+        return value ? value.value().length() + separators : 0;
+    };
+    return length(raw_scheme, 1) + length(raw_authority, 2) + raw_path.length() +
+           length(raw_query, 1) + length(raw_fragment, 1);
+}
+
+// IPv4 addresses are kept in the first bytes of an IPv6Address, see Uri.
+inline uri::IPv6Address AddressOf(uri::IPv4Address ipv4) {
+    return { static_cast<uint8_t>(ipv4 >> 24), static_cast<uint8_t>(ipv4 >> 16),
+             static_cast<uint8_t>(ipv4 >> 8), static_cast<uint8_t>(ipv4) };
+}
+
+inline uri::IPv4Address IPv4AddressOf(const uri::IPv6Address& address) {
+    return (static_cast<uri::IPv4Address>(address[0]) << 24) | (static_cast<uri::IPv4Address>(address[1]) << 16) |
+           (static_cast<uri::IPv4Address>(address[2]) << 8) | static_cast<uri::IPv4Address>(address[3]);
+}
+
+// Normalised components of common URIs fit on the stack.
+using ComponentBuffer = uri::__internal::ScratchBuffer<1024>;
+// Keeps a path that starts with "//" from being taken for an authority.
+constexpr std::string_view kPathGuard = "/.";
+
+} // namespace
 
 namespace uri {
 
-std::optional<Uri> Uri::parse(const std::string& input) {
-    __internal::TokenReader reader(input);
-
-    optional_string_t outScheme;
-    optional_string_t outUserInfo;
-    optional_string_t outHost;
-    std::optional<__internal::HostType> outHostType;
-    optional_string_t outPort;
-    optional_string_t outPath;
-    optional_string_t outQuery;
-    optional_string_t outFragment;
-    UriReference(reader, outScheme, 
-                 outUserInfo, outHost, outHostType, outPort,
-                 outPath,
-                 outQuery, outFragment);
-
-    if (reader.hasNext() || !outPath) {
+Uri::Uri(const allocator_type& allocator) noexcept:
+    _buffer(allocator),
+    _ends(),
+    _present(0),
+    _host_type(HostType::kNone),
+    _scheme_id(SchemeId::kNone),
+    _decoded(0),
+    _port_number(0),
+    _address(),
+    _hash(0) {
+    // Empty on purpose.
+}
+
+Uri::Uri(std::string_view path,
+         const optional_string_view_t& query,
+         const optional_string_view_t& fragment,
+         const allocator_type& allocator) noexcept:
+    Uri(allocator) {
+    assign(std::nullopt,
+           std::nullopt, std::nullopt, HostType::kNone, std::nullopt,
+           path,
+           query, fragment);
+}
+
+Uri::Uri(const optional_string_view_t& scheme,
+         const std::optional<Authority>& authority,
+         std::string_view path,
+         const optional_string_view_t& query,
+         const optional_string_view_t& fragment,
+         const allocator_type& allocator) noexcept:
+    Uri(allocator) {
+    if (!authority) {
+        assign(scheme,
+               std::nullopt, std::nullopt, HostType::kNone, std::nullopt,
+               path,
+               query, fragment);
+        return;
+    }
+
+    const auto& value = authority.value();
+    assign(scheme,
+           value.getUserInfo(), value.getHost(),
+           HostTypeOf(value.getHost(), value.isHostIPLiteral()),
+           value.getPort(),
+           path,
+           query, fragment);
+}
+
+Uri::Uri(const UriView& view,
+         const allocator_type& allocator) noexcept:
+    Uri(allocator) {
+    if (!view.getAuthority()) {
+        assign(view.getScheme(),
+               std::nullopt, std::nullopt, HostType::kNone, std::nullopt,
+               view.getPath(),
+               view.getQuery(), view.getFragment());
+        return;
+    }
+
+    const auto& authority = view.getAuthority().value();
+    assign(view.getScheme(),
+           authority.getUserInfo(), authority.getHost(),
+           HostTypeOf(authority.getHost(), authority.isHostIPLiteral()),
+           authority.getPort(),
+           view.getPath(),
+           view.getQuery(), view.getFragment());
+}
+
+std::optional<Uri> Uri::parse(std::string_view input,
+                              const allocator_type& allocator) {
+    auto result = tryParse(input, allocator);
+
+    if (!result) {
         return std::nullopt;
     }
 
-    std::optional<Authority> authority;
-    if (outHost && outHostType) {
-        bool isHostIPLiteral = outHostType.value() == uri::__internal::HostType::kIPLiteral;
-        authority = std::make_optional(Authority(outHost.value(), outPort, outUserInfo, /* isHostIPLiteral= */ isHostIPLiteral));
+    return std::move(result.value());
+}
+
+ParseResult<Uri> Uri::tryParse(std::string_view input,
+                               const allocator_type& allocator) {
+    // Offsets are stored as 32-bit integers, the first byte
+    // that does not fit is reported.
+    if (input.length() > std::numeric_limits<uint32_t>::max()) {
+        return ParseError { ParseErrorCode::kTooLong, std::numeric_limits<uint32_t>::max() };
+    }
+
+    __internal::UriStateMachine machine;
+    if (!machine.feed(input) || !machine.finish()) {
+        return ParseError { machine.getErrorCode(), machine.getErrorPosition() };
+    }
+
+    // A valid input is already serialised, it is copied as is
+    // and only the ends of the components are taken from the machine.
+    Uri uri(allocator);
+    uri._buffer.assign(input);
+    uri.assignParsed(machine);
+
+    return uri;
+}
+
+std::optional<AuthorityView> Uri::getAuthority() const {
+    if (!has(kHost)) {
+        return std::nullopt;
+    }
+
+    return AuthorityView(getComponent(kHost).value(),
+                         getComponent(kPort),
+                         getComponent(kUserInfo),
+                         /* is_host_ip_literal= */ _host_type == HostType::kIPLiteral,
+                         (_decoded & kDecodedIPv4) ? std::make_optional(IPv4AddressOf(_address)) : std::nullopt,
+                         (_decoded & kDecodedIPv6) ? std::make_optional(_address) : std::nullopt,
+                         (_decoded & kDecodedPortNumber) ? std::make_optional(_port_number) : std::nullopt);
+}
+
+size_t Uri::beginOf(Component component) const {
+    const size_t literal = (_host_type == HostType::kIPLiteral) ? 1 : 0;
+
+    // scheme ":" "//"
+    size_t authority = has(kScheme) ? _ends[kScheme] + 1 : 0;
+    if (has(kHost)) {
+        authority += 2;
     }
 
-    return Uri(outScheme, authority, outPath.value(), outQuery, outFragment);
+    switch (component) {
+        case kScheme:
+            return 0;
+        case kUserInfo:
+            return authority;
+        case kHost:
+            // userinfo "@" "["
+            return (has(kUserInfo) ? _ends[kUserInfo] + 1 : authority) + literal;
+        case kPort:
+            // host "]" ":"
+            return _ends[kHost] + literal + 1;
+        case kPath:
+            if (!has(kHost)) {
+                return authority;
+            }
+            return has(kPort) ? _ends[kPort] : _ends[kHost] + literal;
+        case kQuery:
+            return _ends[kPath] + 1;
+        case kFragment:
+            return (has(kQuery) ? _ends[kQuery] : _ends[kPath]) + 1;
+        default:
+            return 0;
+    }
 }
 
-std::optional<Uri> Uri::fromParts(const std::string& raw_path,
-                                  const optional_string_t& raw_scheme,
-                                  const optional_string_t& raw_authority,
-                                  const optional_string_t& raw_query,
-                                  const optional_string_t& raw_fragment) {
-    optional_string_t outScheme;
+void Uri::updateHash() {
+    _hash = __internal::HashOf(_buffer);
+}
+
+void Uri::assignParsed(const __internal::UriStateMachine& machine) {
+    const std::array<__internal::UriStateMachine::Range, kComponentsCount> ranges = {
+        machine.getScheme(),
+        machine.getUserInfo(),
+        machine.getHost(),
+        machine.getPort(),
+        machine.getPath(),
+        machine.getQuery(),
+        machine.getFragment()
+    };
+
+    for (size_t component = 0; component < kComponentsCount; component++) {
+        if (ranges[component].present) {
+            _ends[component] = static_cast<uint32_t>(ranges[component].end);
+            _present |= static_cast<uint8_t>(1U << component);
+        }
+    }
+    _host_type = __internal::ToPublicHostType(machine.getHostType());
+    _scheme_id = machine.getSchemeId();
+    setDecoded(machine.getIPv4(), machine.getIPv6(), machine.getPortNumber());
+    updateHash();
+}
+
+void Uri::decodeAuthority() {
+    setDecoded((_host_type == HostType::kIPv4) ? ParseIPv4Address(getComponent(kHost).value()) : std::nullopt,
+               (_host_type == HostType::kIPLiteral) ? ParseIPv6Address(getComponent(kHost).value()) : std::nullopt,
+               has(kPort) ? ParsePortNumber(getComponent(kPort).value()) : std::nullopt);
+}
+
+void Uri::setDecoded(const std::optional<IPv4Address>& ipv4,
+                     const std::optional<IPv6Address>& ipv6,
+                     const std::optional<uint16_t>& port_number) {
+    _decoded = 0;
+    _address = IPv6Address();
+    if (ipv4) {
+        _address = AddressOf(ipv4.value());
+        _decoded |= kDecodedIPv4;
+    } else if (ipv6) {
+        _address = ipv6.value();
+        _decoded |= kDecodedIPv6;
+    }
+
+    _port_number = port_number.value_or(0);
+    if (port_number) {
+        _decoded |= kDecodedPortNumber;
+    }
+}
+
+void Uri::markEnd(Component component) {
+    // Offsets are stored as 32-bit integers.
+    assert(_buffer.length() <= std::numeric_limits<uint32_t>::max());
+    _ends[component] = static_cast<uint32_t>(_buffer.length());
+    _present |= static_cast<uint8_t>(1U << component);
+}
+
+void Uri::append(Component component, std::string_view value) {
+    _buffer.append(value);
+    markEnd(component);
+}
+
+void Uri::assign(const optional_string_view_t& scheme,
+                 const optional_string_view_t& userInfo,
+                 const optional_string_view_t& host,
+                 HostType hostType,
+                 const optional_string_view_t& port,
+                 std::string_view path,
+                 const optional_string_view_t& query,
+                 const optional_string_view_t& fragment) {
+    const auto length = [](const optional_string_view_t& value) {
+        return value ? value.value().length() + 1 : 0;
+    };
+    // Separators are counted with the components, "//" and "[]" are extra.
+    _buffer.reserve(length(scheme) + 2 + length(userInfo) + 2 + length(host) + length(port) +
+                    path.length() + length(query) + length(fragment));
+
+    if (scheme) {
+        append(kScheme, scheme.value());
+        _buffer.push_back(':');
+        _scheme_id = __internal::RecognizeScheme(scheme.value());
+    }
+
+    if (host) {
+        _buffer.append("//");
+
+        if (userInfo) {
+            append(kUserInfo, userInfo.value());
+            _buffer.push_back(kUserInfoSeparator);
+        }
+
+        if (hostType == HostType::kIPLiteral) {
+            _buffer.push_back(kIPLiteralBegin);
+        }
+        append(kHost, host.value());
+        if (hostType == HostType::kIPLiteral) {
+            _buffer.push_back(kIPLiteralEnd);
+        }
+
+        if (port) {
+            _buffer.push_back(kPortSeparator);
+            append(kPort, port.value());
+        }
+
+        _host_type = hostType;
+    }
+
+    append(kPath, path);
+
+    if (query) {
+        _buffer.push_back('?');
+        append(kQuery, query.value());
+    }
+
+    if (fragment) {
+        _buffer.push_back('#');
+        append(kFragment, fragment.value());
+    }
+
+    decodeAuthority();
+    updateHash();
+}
+
+std::optional<Uri> Uri::fromParts(std::string_view raw_path,
+                                  const optional_string_view_t& raw_scheme,
+                                  const optional_string_view_t& raw_authority,
+                                  const optional_string_view_t& raw_query,
+                                  const optional_string_view_t& raw_fragment,
+                                  const allocator_type& allocator) {
+    // Offsets are stored as 32-bit integers.
+    if (SerialisedLengthOf(raw_path, raw_scheme, raw_authority, raw_query, raw_fragment) >
+        std::numeric_limits<uint32_t>::max()) {
+        return std::nullopt;
+    }
+
+    optional_string_view_t outScheme;
     std::optional<Authority> outAuthority;
-    optional_string_t outPath;
-    optional_string_t outQuery;
-    optional_string_t outFragment;
+    optional_string_view_t outPath;
+    optional_string_view_t outQuery;
+    optional_string_view_t outFragment;
 
     __internal::TokenReader pathReader(raw_path);
     if (!Path(pathReader, outPath) || pathReader.hasNext()) {
@@ -67,23 +423,231 @@ std::optional<Uri> Uri::fromParts(const std::string& raw_path,
 
     if (raw_query) {
         __internal::TokenReader queryReader(raw_query.value());
-        if (!queryFragment(queryReader, outScheme) || queryReader.hasNext()) {
+        if (!queryFragment(queryReader, outQuery) || queryReader.hasNext()) {
             return std::nullopt;
         }
     }
 
     if (raw_fragment) {
         __internal::TokenReader fragmentReader(raw_fragment.value());
-        if (!queryFragment(fragmentReader, outScheme) || fragmentReader.hasNext()) {
+        if (!queryFragment(fragmentReader, outFragment) || fragmentReader.hasNext()) {
             return std::nullopt;
         }
     }
 
-    return Uri(outScheme, outAuthority, outPath.value(), outQuery, outFragment);
+    return Uri(outScheme,
+               outAuthority,
+               outPath.value(),
+               outQuery,
+               outFragment,
+               allocator);
+}
+
+bool Uri::isNormalised() const {
+    using __internal::ScanCharClass;
+    using __internal::kLowercaseHostSet;
+
+    const auto scheme = getScheme();
+    if (scheme && ScanCharClass(scheme.value(), kLowercaseHostSet) < scheme->length()) {
+        return false;
+    }
+
+    // Triplets are checked in a single scan over everything after the scheme,
+    // the separators of the components are reserved characters.
+    const std::string_view rest = std::string_view(_buffer).substr(scheme ? _ends[kScheme] + 1 : 0);
+    if (!__internal::IsPctNormalised(rest, __internal::kPathCodingSet)) {
+        return false;
+    }
+
+    const auto default_port = DefaultPortOf(_scheme_id);
+    if (has(kHost)) {
+        const std::string_view host = getComponent(kHost).value();
+        if (ScanCharClass(host, kLowercaseHostSet) < host.length()) {
+            return false;
+        }
+
+        if (has(kPort) && (getComponent(kPort)->empty() || IsDefaultPort(getComponent(kPort).value(), default_port))) {
+            return false;
+        }
+
+        if (default_port && getPath().empty()) {
+            return false;
+        }
+    }
+
+    // The "/." that keeps "//" from starting an authority stays.
+    std::string_view path = getPath();
+    if (!has(kHost) && path.substr(0, 4) == "/.//") {
+        path.remove_prefix(2);
+    }
+
+    return !HasRemovableDotSegments(scheme, path) || !path::HasDotSegments(path);
+}
+
+template<typename Emit>
+void Uri::forEachNormalisedPiece(Emit&& emit) const {
+    using __internal::PctNormalise;
+    using __internal::kPathCodingSet;
+
+    // The components are valid, so nothing is encoded and
+    // normalised components are never longer than the original ones.
+    ComponentBuffer buffer(kPathGuard.length() + _buffer.length());
+    char* const scratch = buffer.data();
+    const auto piece = [scratch](const char* end) {
+        return std::string_view(scratch, static_cast<size_t>(end - scratch));
+    };
+
+    const auto scheme = getScheme();
+    if (_scheme_id != SchemeId::kNone && _scheme_id != SchemeId::kOther) {
+        emit(SchemeNameOf(_scheme_id), kScheme);
+        emit(":", kComponentsCount);
+    } else if (scheme) {
+        for (size_t i = 0; i < scheme->length(); i++) {
+            scratch[i] = ToLower(scheme.value()[i]);
+        }
+        emit(std::string_view(scratch, scheme->length()), kScheme);
+        emit(":", kComponentsCount);
+    }
+
+    const auto default_port = DefaultPortOf(_scheme_id);
+    if (has(kHost)) {
+        emit("//", kComponentsCount);
+
+        if (has(kUserInfo)) {
+            emit(piece(PctNormalise(getComponent(kUserInfo).value(), kPathCodingSet, scratch)), kUserInfo);
+            emit(std::string_view(&kUserInfoSeparator, 1), kComponentsCount);
+        }
+
+        if (_host_type == HostType::kIPLiteral) {
+            emit(std::string_view(&kIPLiteralBegin, 1), kComponentsCount);
+        }
+        char* host_end = PctNormalise(getComponent(kHost).value(), kPathCodingSet, scratch);
+        LowercaseHost(scratch, host_end);
+        emit(piece(host_end), kHost);
+        if (_host_type == HostType::kIPLiteral) {
+            emit(std::string_view(&kIPLiteralEnd, 1), kComponentsCount);
+        }
+
+        const auto port = getComponent(kPort);
+        if (port && !port->empty() && !IsDefaultPort(port.value(), default_port)) {
+            emit(std::string_view(&kPortSeparator, 1), kComponentsCount);
+            emit(port.value(), kPort);
+        }
+    }
+
+    // Room for the guard is left in front of the path.
+    char* path_begin = scratch + kPathGuard.length();
+    char* path_end = PctNormalise(getPath(), kPathCodingSet, path_begin);
+    if (HasRemovableDotSegments(scheme, getPath())) {
+        path_end = path::RemoveDotSegments(std::string_view(path_begin, static_cast<size_t>(path_end - path_begin)), path_begin);
+
+        // Without an authority, "//" would start one, see section 5.2.4.
+        if (!has(kHost) && std::string_view(path_begin, static_cast<size_t>(path_end - path_begin)).substr(0, 2) == "//") {
+            path_begin = scratch;
+            std::memcpy(path_begin, kPathGuard.data(), kPathGuard.length());
+        }
+    }
+    if (has(kHost) && default_port && path_begin == path_end) {
+        emit("/", kPath);
+    } else {
+        emit(std::string_view(path_begin, static_cast<size_t>(path_end - path_begin)), kPath);
+    }
+
+    if (has(kQuery)) {
+        emit("?", kComponentsCount);
+        emit(piece(PctNormalise(getComponent(kQuery).value(), kPathCodingSet, scratch)), kQuery);
+    }
+
+    if (has(kFragment)) {
+        emit("#", kComponentsCount);
+        emit(piece(PctNormalise(getComponent(kFragment).value(), kPathCodingSet, scratch)), kFragment);
+    }
+}
+
+Uri Uri::normalised(const allocator_type& allocator) const {
+    if (isNormalised()) {
+        return Uri(*this, allocator);
+    }
+
+    // Normalisation only shrinks a URI, but for the "/" of an empty path.
+    Uri uri(allocator);
+    uri._buffer.reserve(_buffer.length() + 1);
+    uri._scheme_id = _scheme_id;
+
+    forEachNormalisedPiece([this, &uri](std::string_view piece, Component component) {
+        uri._buffer.append(piece);
+        if (component == kComponentsCount) {
+            return;
+        }
+
+        uri.markEnd(component);
+        // Decoding may turn a reg-name into an IPv4 address, e.g. "%31.1.1.1".
+        if (component == kHost) {
+            uri._host_type = (_host_type == HostType::kIPLiteral) ? HostType::kIPLiteral : HostTypeOf(piece, false);
+        }
+    });
+    uri.decodeAuthority();
+    uri.updateHash();
+
+    return uri;
+}
+
+Fingerprint Uri::getFingerprint() const {
+    return __internal::FingerprintOf(_buffer);
+}
+
+uint64_t Uri::getNormalisedHash() const {
+    if (isNormalised()) {
+        return _hash;
+    }
+
+    __internal::Hasher hasher;
+    forEachNormalisedPiece([&hasher](std::string_view piece, Component) {
+        hasher.update(piece);
+    });
+    return hasher.hash();
+}
+
+Fingerprint Uri::getNormalisedFingerprint() const {
+    if (isNormalised()) {
+        return getFingerprint();
+    }
+
+    __internal::Hasher hasher;
+    forEachNormalisedPiece([&hasher](std::string_view piece, Component) {
+        hasher.update(piece);
+    });
+    return hasher.fingerprint();
+}
+
+std::optional<Uri> Uri::resolve(const Uri& base,
+                                const Uri& reference,
+                                const allocator_type& allocator) {
+    const auto resolved_base = ResolvedBase::from(base);
+    if (!resolved_base) {
+        return std::nullopt;
+    }
+
+    return resolved_base->resolve(reference, allocator);
+}
+
+std::optional<Uri> Uri::relativize(const Uri& base,
+                                   const Uri& target,
+                                   const allocator_type& allocator) {
+    const auto resolved_base = ResolvedBase::from(base);
+    if (!resolved_base) {
+        return std::nullopt;
+    }
+
+    return resolved_base->relativize(target, allocator);
 }
 
 std::string Uri::normalisePath(const std::string& path) {
     return path::Normalise(path);
 }
 
+void Uri::normalisePathInPlace(std::string& path) {
+    path::NormaliseInPlace(path);
+}
+
 } // namepsace uri
@@ -0,0 +1,107 @@
+#include "uri_batch.h"
+
+#include <limits>
+
+#include "uri_parser.h"
+#include "detail/uri_state_machine.h"
+
+namespace uri {
+
+std::optional<std::string_view> UriBatch::getComponent(size_t index, Component component) const {
+    if (!hasComponent(index, component)) {
+        return std::nullopt;
+    }
+
+    return _inputs[index].substr(getOffsets(component)[index], getLengths(component)[index]);
+}
+
+std::optional<UriView> UriBatch::getView(size_t index) const {
+    if (!isValid(index)) {
+        return std::nullopt;
+    }
+
+    std::optional<AuthorityView> authority;
+    if (_host_types[index] != HostType::kNone) {
+        authority = std::make_optional(AuthorityView(getComponent(index, Component::kHost).value(),
+                                                     getComponent(index, Component::kPort),
+                                                     getComponent(index, Component::kUserInfo),
+                                                     /* isHostIPLiteral= */ _host_types[index] == HostType::kIPLiteral));
+    }
+
+    return UriView(getComponent(index, Component::kScheme),
+                   authority,
+                   getComponent(index, Component::kPath).value(),
+                   getComponent(index, Component::kQuery),
+                   getComponent(index, Component::kFragment));
+}
+
+void UriBatch::resize(size_t count) {
+    // Every entry is overwritten by parseBatch,
+    // resizing is needed only to reuse the capacity.
+    _inputs.resize(count);
+    _validity.assign((count + 63) / 64, 0);
+    _presence.resize(count);
+    _host_types.resize(count);
+    for (size_t component = 0; component < kComponentsCount; component++) {
+        _offsets[component].resize(count);
+        _lengths[component].resize(count);
+    }
+}
+
+void UriBatch::parseRange(const std::string_view* inputs, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const auto& input = inputs[i];
+        _inputs[i] = input;
+
+        __internal::UriStateMachine machine;
+        // Offsets are stored as 32-bit integers.
+        bool valid = input.length() <= std::numeric_limits<uint32_t>::max() &&
+                     machine.feed(input) && machine.finish();
+
+        if (!valid) {
+            _presence[i] = 0;
+            _host_types[i] = HostType::kNone;
+            for (size_t component = 0; component < kComponentsCount; component++) {
+                _offsets[component][i] = 0;
+                _lengths[component][i] = 0;
+            }
+            continue;
+        }
+
+        _validity[i / 64] |= uint64_t{1} << (i % 64);
+
+        const std::array<__internal::UriStateMachine::Range, kComponentsCount> ranges = {
+            machine.getScheme(),
+            machine.getUserInfo(),
+            machine.getHost(),
+            machine.getPort(),
+            machine.getPath(),
+            machine.getQuery(),
+            machine.getFragment()
+        };
+
+        uint8_t presence = 0;
+        for (size_t component = 0; component < kComponentsCount; component++) {
+            const auto& range = ranges[component];
+            presence |= static_cast<uint8_t>(range.present) << component;
+            _offsets[component][i] = range.present ? static_cast<uint32_t>(range.begin) : 0;
+            _lengths[component][i] = range.present ? static_cast<uint32_t>(range.length()) : 0;
+        }
+        _presence[i] = presence;
+
+        _host_types[i] = __internal::ToPublicHostType(machine.getHostType());
+    }
+}
+
+void parseBatch(const std::string_view* inputs, size_t count, UriBatch& outBatch) {
+    outBatch.resize(count);
+    outBatch.parseRange(inputs, 0, count);
+}
+
+UriBatch parseBatch(const std::vector<std::string_view>& inputs) {
+    UriBatch batch;
+    parseBatch(inputs.data(), inputs.size(), batch);
+    return batch;
+}
+
+} // namespace uri
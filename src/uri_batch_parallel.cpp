@@ -0,0 +1,122 @@
+#include "uri_batch.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include "work_stealing.h"
+
+namespace {
+
+// Chunks are multiples of 64 inputs, so that different chunks
+// never share words of the validity bitmap.
+constexpr size_t kChunkSize = 1024;
+
+// Keeps ranges of different workers in different cache lines.
+struct alignas(64) WorkerRange {
+    uri::__internal::StealableRange range;
+};
+
+size_t ResolveThreadsCount(size_t threads, size_t chunks) {
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    return std::max<size_t>(std::min(threads, chunks), 1);
+}
+
+} // namespace
+
+namespace uri {
+
+void parseBatchParallel(const std::string_view* inputs, size_t count,
+                        UriBatch& outBatch, size_t threads) {
+    outBatch.resize(count);
+
+    const size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+    threads = ResolveThreadsCount(threads, chunks);
+
+    if (threads == 1 || chunks > std::numeric_limits<uint32_t>::max()) {
+        outBatch.parseRange(inputs, 0, count);
+        return;
+    }
+
+    // Every worker starts with an equal share of the chunks.
+    std::unique_ptr<WorkerRange[]> ranges(new WorkerRange[threads]);
+    for (size_t worker = 0; worker < threads; worker++) {
+        ranges[worker].range.reset(static_cast<uint32_t>(chunks * worker / threads),
+                                   static_cast<uint32_t>(chunks * (worker + 1) / threads));
+    }
+
+    const auto parseChunk = [&](uint32_t chunk) {
+        const size_t begin = chunk * kChunkSize;
+        outBatch.parseRange(inputs, begin, std::min(begin + kChunkSize, count));
+    };
+
+    const auto work = [&](size_t worker) {
+        auto& own = ranges[worker].range;
+        uint32_t chunk;
+        while (true) {
+            while (own.pop(chunk)) {
+                parseChunk(chunk);
+            }
+
+            // Out of own chunks, look for a victim.
+            uint32_t stolenBegin;
+            uint32_t stolenEnd;
+            bool stolen = false;
+            for (size_t offset = 1; offset < threads && !stolen; offset++) {
+                stolen = ranges[(worker + offset) % threads].range.steal(stolenBegin, stolenEnd);
+            }
+
+            // Chunks are never added, so nothing is left
+            // to do once every other range is empty.
+            if (!stolen) {
+                return;
+            }
+
+            own.reset(stolenBegin, stolenEnd);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t worker = 1; worker < threads; worker++) {
+        workers.emplace_back(work, worker);
+    }
+    // The calling thread is a worker too.
+    work(0);
+
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+UriBatch parseBatchParallel(const std::vector<std::string_view>& inputs, size_t threads) {
+    UriBatch batch;
+    parseBatchParallel(inputs.data(), inputs.size(), batch, threads);
+    return batch;
+}
+
+UriBatch parseLinesParallel(std::string_view buffer, size_t threads) {
+    std::vector<std::string_view> lines;
+    size_t begin = 0;
+    while (begin < buffer.length()) {
+        size_t end = buffer.find('\n', begin);
+        if (end == std::string_view::npos) {
+            end = buffer.length();
+        }
+
+        std::string_view line = buffer.substr(begin, end - begin);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        lines.push_back(line);
+
+        begin = end + 1;
+    }
+
+    return parseBatchParallel(lines, threads);
+}
+
+} // namespace uri
@@ -1,75 +1,84 @@
 #include "uri_parser.h"
 
+#include "detail/char_classes.h"
+#include "detail/char_scanner.h"
+#include "detail/ip_recognizers.h"
 #include "token_reader.h"
+#include "detail/uri_state_machine.h"
 
 namespace {
 
-bool IsAlpha(char c) {
-    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
-}
-
-bool IsDigit(char c) {
-    return c >= '0' && c <= '9';
-}
-
-// The uppercase hexadecimal digits 'A' through 'F' are equivalent to
-// the lowercase digits 'a' through 'f', respectively.
-bool IsHexDigit(char c) {
-    return IsDigit(c) ||
-           (c >= 'a' && c <= 'f') ||
-           (c >= 'A' && c <= 'F');
-}
-
-bool IsSubDelims(char c) {
-    return (c == '!') || (c == '$') || (c == '&') || (c == '\'') ||
-           (c == '(') || (c == ')') || (c == '*') || (c == '+') ||
-           (c == ',') || (c == ';') || (c == '=');
-}
-
-bool IsUnreserved(char c) {
-    return IsAlpha(c) || IsDigit(c) ||
-           (c == '-') || (c == '.') ||
-           (c == '_') || (c == '~');
-}
+using uri::__internal::HasCharClass;
 
-bool ConsumeAlpha(uri::__internal::TokenReader& reader) {
-    if (IsAlpha(reader.peek())) {
+bool ConsumeCharClass(uri::__internal::TokenReader& reader,
+                      uri::__internal::char_class_t char_class) {
+    if (HasCharClass(reader.peek(), char_class)) {
         reader.next();
         return true;
     }
     return false;
 }
 
+bool ConsumeAlpha(uri::__internal::TokenReader& reader) {
+    return ConsumeCharClass(reader, uri::__internal::kAlpha);
+}
+
 bool ConsumeDigit(uri::__internal::TokenReader& reader) {
-    if (IsDigit(reader.peek())) {
-        reader.next();
-        return true;
-    }
-    return false;
+    return ConsumeCharClass(reader, uri::__internal::kDigit);
 }
 
 bool ConsumeHexDigit(uri::__internal::TokenReader& reader) {
-    if (IsHexDigit(reader.peek())) {
-        reader.next();
-        return true;
-    }
-    return false;
+    return ConsumeCharClass(reader, uri::__internal::kHexDigit);
 }
 
-bool ConsumeSubDelims(uri::__internal::TokenReader& reader) {
-    if (IsSubDelims(reader.peek())) {
-        reader.next();
-        return true;
+void AssignRange(std::string_view text,
+                 const uri::__internal::UriStateMachine::Range& range,
+                 std::optional<std::string_view>& outValue) {
+    if (!range.present) {
+        outValue = std::nullopt;
+        return;
     }
-    return false;
+    // The machine has already checked the bounds.
+    outValue.emplace(text.data() + range.begin, range.length());
 }
 
-bool ConsumeUnreserved(uri::__internal::TokenReader& reader) {
-    if (IsUnreserved(reader.peek())) {
-        reader.next();
-        return true;
+// Matches the rest of the reader with UriStateMachine.
+bool ConsumeWithStateMachine(uri::__internal::TokenReader& reader,
+                             bool require_scheme,
+                             std::optional<std::string_view>& outScheme,
+                             std::optional<std::string_view>& outUserInfo,
+                             std::optional<std::string_view>& outHost,
+                             std::optional<uri::__internal::HostType>& outHostType,
+                             std::optional<std::string_view>& outPort,
+                             std::optional<std::string_view>& outPath,
+                             std::optional<std::string_view>& outQuery,
+                             std::optional<std::string_view>& outFragment) {
+    std::string_view text = reader.remaining();
+
+    uri::__internal::UriStateMachine machine(require_scheme);
+    if (!machine.feed(text) || !machine.finish()) {
+        outScheme = std::nullopt;
+        outUserInfo = std::nullopt;
+        outHost = std::nullopt;
+        outHostType = std::nullopt;
+        outPort = std::nullopt;
+        outPath = std::nullopt;
+        outQuery = std::nullopt;
+        outFragment = std::nullopt;
+        return false;
     }
-    return false;
+
+    AssignRange(text, machine.getScheme(), outScheme);
+    AssignRange(text, machine.getUserInfo(), outUserInfo);
+    AssignRange(text, machine.getHost(), outHost);
+    outHostType = machine.getHostType();
+    AssignRange(text, machine.getPort(), outPort);
+    AssignRange(text, machine.getPath(), outPath);
+    AssignRange(text, machine.getQuery(), outQuery);
+    AssignRange(text, machine.getFragment(), outFragment);
+
+    reader.skip(text.length());
+    return true;
 }
 
 } // namespace
@@ -79,98 +88,48 @@ namespace uri {
 
 namespace __internal {
 
+// URI-reference = URI / relative-ref
+// Both alternatives are recognized at once by UriStateMachine,
+// the input is read only once and without backtracking.
 bool UriReference(TokenReader& reader,
-                  std::optional<std::string>& outScheme,
-                  std::optional<std::string>& outUserInfo,
-                  std::optional<std::string>& outHost,
+                  std::optional<std::string_view>& outScheme,
+                  std::optional<std::string_view>& outUserInfo,
+                  std::optional<std::string_view>& outHost,
                   std::optional<HostType>& outHostType,
-                  std::optional<std::string>& outPort,
-                  std::optional<std::string>& outPath,
-                  std::optional<std::string>& outQuery,
-                  std::optional<std::string>& outFragment) {
-    auto token = reader.save();
-
-    if (Uri(reader, outScheme,
-            outUserInfo, outHost, outHostType, outPort,
-            outPath, outQuery, outFragment) ||
-        relativeRef(reader,
-                    outUserInfo, outHost, outHostType, outPort,
-                    outPath, outQuery, outFragment)) {
-
-        // Math only the entire input.
-        if (!reader.hasNext()) {
-            return true;
-        }
-    }
-
-    outScheme = std::nullopt;
-    outUserInfo = std::nullopt;
-    outHost = std::nullopt;
-    outHostType = std::nullopt;
-    outPort = std::nullopt;
-    outPath = std::nullopt;
-    outQuery = std::nullopt;
-    outFragment = std::nullopt;
-    reader.restore(token);
-    return false;
+                  std::optional<std::string_view>& outPort,
+                  std::optional<std::string_view>& outPath,
+                  std::optional<std::string_view>& outQuery,
+                  std::optional<std::string_view>& outFragment) {
+    return ConsumeWithStateMachine(reader, /* require_scheme= */ false,
+                                   outScheme,
+                                   outUserInfo, outHost, outHostType, outPort,
+                                   outPath, outQuery, outFragment);
 }
 
+// URI = scheme ":" hier-part [ "?" query ] [ "#" fragment ]
 bool Uri(TokenReader& reader,
-         std::optional<std::string>& outScheme,
-         std::optional<std::string>& outUserInfo,
-         std::optional<std::string>& outHost,
+         std::optional<std::string_view>& outScheme,
+         std::optional<std::string_view>& outUserInfo,
+         std::optional<std::string_view>& outHost,
          std::optional<HostType>& outHostType,
-         std::optional<std::string>& outPort,
-         std::optional<std::string>& outPath,
-         std::optional<std::string>& outQuery,
-         std::optional<std::string>& outFragment) {
-    auto token = reader.save();
-
-    if (scheme(reader, outScheme) &&
-        reader.consume(':') &&
-        hierPart(reader,
-                 outUserInfo, outHost, outHostType, outPort,
-                 outPath)) {
-        auto optional1_token = reader.save();
-        if (reader.consume('?')) {
-            if (!queryFragment(reader, outQuery)) {
-                reader.restore(optional1_token);
-            }
-        }
-
-        auto optional2_token = reader.save();
-        if (reader.consume('#')) {
-            if (!queryFragment(reader, outFragment)) {
-                reader.restore(optional2_token);
-            }
-        }
-
-        // Math only the entire input.
-        if (!reader.hasNext()) {
-            return true;
-        }
-    }
-
-    outScheme = std::nullopt;
-    outUserInfo = std::nullopt;
-    outHost = std::nullopt;
-    outHostType = std::nullopt;
-    outPort = std::nullopt;
-    outPath = std::nullopt;
-    outQuery = std::nullopt;
-    outFragment = std::nullopt;
-    reader.restore(token);
-    return false;
+         std::optional<std::string_view>& outPort,
+         std::optional<std::string_view>& outPath,
+         std::optional<std::string_view>& outQuery,
+         std::optional<std::string_view>& outFragment) {
+    return ConsumeWithStateMachine(reader, /* require_scheme= */ true,
+                                   outScheme,
+                                   outUserInfo, outHost, outHostType, outPort,
+                                   outPath, outQuery, outFragment);
 }
 
 bool AbsoluteUri(TokenReader& reader,
-                 std::optional<std::string>& outScheme,
-                 std::optional<std::string>& outUserInfo,
-                 std::optional<std::string>& outHost,
+                 std::optional<std::string_view>& outScheme,
+                 std::optional<std::string_view>& outUserInfo,
+                 std::optional<std::string_view>& outHost,
                  std::optional<HostType>& outHostType,
-                 std::optional<std::string>& outPort,
-                 std::optional<std::string>& outPath,
-                 std::optional<std::string>& outQuery) {
+                 std::optional<std::string_view>& outPort,
+                 std::optional<std::string_view>& outPath,
+                 std::optional<std::string_view>& outQuery) {
     auto token = reader.save();
 
     if (scheme(reader, outScheme) &&
@@ -212,7 +171,7 @@ bool AbsoluteUri(TokenReader& reader,
 //      / path-rootless   ; begins with a segment
 //      / path-empty      ; zero characters
 bool Path(TokenReader& reader,
-          std::optional<std::string>& value) {
+          std::optional<std::string_view>& value) {
     auto token = reader.save();
 
     if (pathAbsolute(reader, value) && !reader.hasNext()) {
@@ -244,7 +203,7 @@ bool Path(TokenReader& reader,
 // Internal tokens.
 
 bool scheme(TokenReader& reader,
-            std::optional<std::string>& value) {
+            std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
@@ -253,8 +212,7 @@ bool scheme(TokenReader& reader,
         return false;
     }
 
-    while (ConsumeAlpha(reader) || ConsumeDigit(reader) ||
-        reader.consume('+') || reader.consume('-') || reader.consume('.')) {
+    while (ConsumeCharClass(reader, kScheme)) {
     }
 
     value = reader.extract(token);
@@ -262,25 +220,22 @@ bool scheme(TokenReader& reader,
 }
 
 bool queryFragment(TokenReader& reader,
-                   std::optional<std::string>& value) {
+                   std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
-    while (pchar(reader) ||
-        reader.consume('/') ||
-        reader.consume('?')) {
-    }
+    reader.skip(ScanCharClass(reader.remaining(), kQueryFragmentSet));
 
     value = reader.extract(token);
     return true;
 }
 
 bool hierPart(TokenReader& reader,
-              std::optional<std::string>& outUserInfo,
-              std::optional<std::string>& outHost,
+              std::optional<std::string_view>& outUserInfo,
+              std::optional<std::string_view>& outHost,
               std::optional<HostType>& outHostType,
-              std::optional<std::string>& outPort,
-              std::optional<std::string>& outPath) {
+              std::optional<std::string_view>& outPort,
+              std::optional<std::string_view>& outPath) {
     auto token = reader.save();
 
     if (reader.consumeAll("//") &&
@@ -309,13 +264,13 @@ bool hierPart(TokenReader& reader,
 }
 
 bool relativeRef(TokenReader& reader,
-                 std::optional<std::string>& outUserInfo,
-                 std::optional<std::string>& outHost,
+                 std::optional<std::string_view>& outUserInfo,
+                 std::optional<std::string_view>& outHost,
                  std::optional<HostType>& outHostType,
-                 std::optional<std::string>& outPort,
-                 std::optional<std::string>& outPath,
-                 std::optional<std::string>& outQuery,
-                 std::optional<std::string>& outFragment) {
+                 std::optional<std::string_view>& outPort,
+                 std::optional<std::string_view>& outPath,
+                 std::optional<std::string_view>& outQuery,
+                 std::optional<std::string_view>& outFragment) {
     auto token = reader.save();
 
     if (!relativePart(reader,
@@ -343,11 +298,11 @@ bool relativeRef(TokenReader& reader,
 }
 
 bool relativePart(TokenReader& reader,
-                  std::optional<std::string>& outUserInfo,
-                  std::optional<std::string>& outHost,
+                  std::optional<std::string_view>& outUserInfo,
+                  std::optional<std::string_view>& outHost,
                   std::optional<HostType>& outHostType,
-                  std::optional<std::string>& outPort,
-                  std::optional<std::string>& outPath) {
+                  std::optional<std::string_view>& outPort,
+                  std::optional<std::string_view>& outPath) {
     auto token = reader.save();
 
     if (reader.consumeAll("//") &&
@@ -376,10 +331,10 @@ bool relativePart(TokenReader& reader,
 }
 
 bool authority(TokenReader& reader,
-               std::optional<std::string>& outUserInfo,
-               std::optional<std::string>& outHost,
+               std::optional<std::string_view>& outUserInfo,
+               std::optional<std::string_view>& outHost,
                std::optional<HostType>& outHostType,
-               std::optional<std::string>& outPort) {
+               std::optional<std::string_view>& outPort) {
     auto token = reader.save();
 
     if (userInfo(reader, outUserInfo)) {
@@ -407,20 +362,18 @@ bool authority(TokenReader& reader,
 }
 
 bool userInfo(TokenReader& reader,
-              std::optional<std::string>& value) {
+              std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
-    while (ConsumeUnreserved(reader) || pctEncoded(reader)
-        || ConsumeSubDelims(reader) || reader.consume(':')) {
-    }
+    reader.skip(ScanCharClass(reader.remaining(), kUserInfoSet));
 
     value = reader.extract(token);
     return true;
 }
 
 bool host(TokenReader& reader,
-          std::optional<std::string>& outHost,
+          std::optional<std::string_view>& outHost,
           std::optional<HostType>& outHostType) {
     outHostType = std::nullopt;
     auto token = reader.save();
@@ -430,9 +383,15 @@ bool host(TokenReader& reader,
         return true;
     }
 
+    // IPv4address should match the entire host,
+    // otherwise it is a prefix of reg-name, e.g. "1.2.3.4.example".
     if (IPv4address(reader, outHost)) {
-        outHostType = std::make_optional(HostType::kIPv4);
-        return true;
+        auto c = reader.peek();
+        if (!HasCharClass(c, kRegName) && c != '%') {
+            outHostType = std::make_optional(HostType::kIPv4);
+            return true;
+        }
+        reader.restore(token);
     }
 
     if (regName(reader, outHost)) {
@@ -445,7 +404,7 @@ bool host(TokenReader& reader,
 }
 
 bool port(TokenReader& reader,
-          std::optional<std::string>& value) {
+          std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
@@ -457,7 +416,7 @@ bool port(TokenReader& reader,
 }
 
 bool IPLiteral(TokenReader& reader,
-               std::optional<std::string>& value) {
+               std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
@@ -485,31 +444,40 @@ bool IPLiteral(TokenReader& reader,
 }
 
 bool IPv4address(TokenReader& reader,
-                 std::optional<std::string>& value) {
+                 std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
-    if (decOctet(reader) && reader.consume('.') &&
-        decOctet(reader) && reader.consume('.') &&
-        decOctet(reader) && reader.consume('.') &&
-        decOctet(reader)) {
-        value = reader.extract(token);
-        return true;
+    // A single pass instead of trying the dec-octet alternatives:
+    // the recognizer stops at the first byte that does not fit.
+    const std::string_view input = reader.remaining();
+    IPv4Recognizer recognizer;
+
+    size_t length = 0;
+    while (length < input.length() &&
+           (HasCharClass(input[length], kDigit) || input[length] == '.')) {
+        if (!recognizer.feed(input[length])) {
+            break;
+        }
+        length += 1;
     }
 
-    reader.restore(token);
-    return false;
+    if (!recognizer.finish()) {
+        reader.restore(token);
+        return false;
+    }
+
+    reader.skip(length);
+    value = reader.extract(token);
+    return true;
 }
 
 bool regName(TokenReader& reader,
-             std::optional<std::string>& value) {
+             std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
-    while (ConsumeUnreserved(reader) ||
-           pctEncoded(reader) ||
-           ConsumeSubDelims(reader)) {
-    }
+    reader.skip(ScanCharClass(reader.remaining(), kRegNameSet));
 
     value = reader.extract(token);
     return true;
@@ -539,7 +507,7 @@ bool IPvFuture(TokenReader& reader) {
     }
 
     repeat_counter = 0;
-    while (ConsumeUnreserved(reader) || ConsumeSubDelims(reader) ||
+    while (ConsumeCharClass(reader, kUnreserved | kSubDelims) ||
         reader.consume(':')) {
         repeat_counter += 1;
     }
@@ -552,262 +520,34 @@ bool IPvFuture(TokenReader& reader) {
     return true;
 }
 
-bool IPv6H16Part(TokenReader& reader) {
-    auto token = reader.save();
-
-    if (h16(reader) && reader.consume(':')) {
-        return true;
-    }
-
-    reader.restore(token);
-    return false;
-}
-
-bool IPv6H16PartRepeatExactly(TokenReader& reader, size_t k) {
-    auto token = reader.save();
-
-    size_t repeat_counter = 0;
-    while (repeat_counter < k && IPv6H16Part(reader)) {
-        repeat_counter += 1;
-    }
-
-    // Cannot be bigger as we broke the loop.
-    if (repeat_counter < k) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6address_optional(TokenReader& reader, size_t k) {
+bool IPv6address(TokenReader& reader) {
     auto token = reader.save();
 
-    size_t repeat_counter = 0;
-    while (repeat_counter < k && IPv6H16Part(reader)) {
-        repeat_counter += 1;
-    }
-
-    if (!h16(reader)) {
-        reader.restore(token);
+    // A single pass instead of trying all nine alternatives:
+    // the decoder stops at the first byte that does not fit.
+    const std::string_view input = reader.remaining();
+    IPv6Decoder decoder;
 
-        size_t kn = 0;
-        if (repeat_counter > 0) {
-            kn = repeat_counter - 1;
-        }
-        repeat_counter = 0;
-
-        while (repeat_counter < kn && IPv6H16Part(reader)) {
-            repeat_counter += 1;
-        }
-
-        if (!h16(reader)) {
+    size_t length = 0;
+    while (length < input.length() &&
+           (HasCharClass(input[length], kHexDigit) || input[length] == ':' || input[length] == '.')) {
+        if (!decoder.feed(input[length])) {
             reader.restore(token);
             return false;
         }
+        length += 1;
     }
 
-    return true;
-}
-
-bool IPv6addressVariation1(TokenReader& reader) {
-    auto token = reader.save();
-    
-    if (!IPv6H16PartRepeatExactly(reader, 6)) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!ls32(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6addressVariation2(TokenReader& reader) {
-    auto token = reader.save();
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-    
-    if (!IPv6H16PartRepeatExactly(reader, 5)) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!ls32(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6addressVariation3(TokenReader& reader) {
-    auto token = reader.save();
-
-    // Optional.
-    h16(reader);
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-    
-    if (!IPv6H16PartRepeatExactly(reader, 4)) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!ls32(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6addressVariation4(TokenReader& reader) {
-    auto token = reader.save();
-
-    IPv6address_optional(reader, 1);
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-    
-    if (!IPv6H16PartRepeatExactly(reader, 3)) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!ls32(reader)) {
+    std::array<uint8_t, 16> address {};
+    if (!decoder.finish(address)) {
         reader.restore(token);
         return false;
     }
 
+    reader.skip(length);
     return true;
 }
 
-bool IPv6addressVariation5(TokenReader& reader) {
-    auto token = reader.save();
-
-    IPv6address_optional(reader, 2);
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-    
-    if (!IPv6H16PartRepeatExactly(reader, 2)) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!ls32(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6addressVariation6(TokenReader& reader) {
-    auto token = reader.save();
-
-    IPv6address_optional(reader, 3);
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-    
-    if (!IPv6H16Part(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!ls32(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6addressVariation7(TokenReader& reader) {
-    auto token = reader.save();
-
-    IPv6address_optional(reader, 4);
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!ls32(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6addressVariation8(TokenReader& reader) {
-    auto token = reader.save();
-
-    IPv6address_optional(reader, 5);
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-
-    if (!h16(reader)) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6addressVariation9(TokenReader& reader) {
-    auto token = reader.save();
-
-    IPv6address_optional(reader, 6);
-
-    if (!reader.consumeAll("::")) {
-        reader.restore(token);
-        return false;
-    }
-
-    return true;
-}
-
-bool IPv6address(TokenReader& reader) {
-    auto token = reader.save();
-
-    if (IPv6addressVariation1(reader) ||
-        IPv6addressVariation2(reader) ||
-        IPv6addressVariation3(reader) ||
-        IPv6addressVariation4(reader) ||
-        IPv6addressVariation5(reader) ||
-        IPv6addressVariation6(reader) ||
-        IPv6addressVariation7(reader) ||
-        IPv6addressVariation8(reader) ||
-        IPv6addressVariation9(reader)) {
-        return true;
-    }
-
-    reader.restore(token);
-    return false;
-}
-
 bool h16(TokenReader& reader) {
     auto token = reader.save();
 
@@ -849,7 +589,7 @@ bool ls32(TokenReader& reader) {
     auto token = reader.save();
 
     // TODO(st235): think about better API to improve the parsing?
-    std::optional<std::string> discarded_value;
+    std::optional<std::string_view> discarded_value;
     if (ls32_Alteration1(reader) ||
         IPv4address(reader, discarded_value)) {
         return true;
@@ -988,7 +728,7 @@ bool path_kleene_slash_segment(TokenReader& reader) {
 }
 
 bool pathAbempty(TokenReader& reader,
-                 std::optional<std::string>& value) {
+                 std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
@@ -1015,7 +755,7 @@ bool pathAbsolute_option1(TokenReader& reader) {
 }
 
 bool pathAbsolute(TokenReader& reader,
-                  std::optional<std::string>& value) {
+                  std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
@@ -1030,7 +770,7 @@ bool pathAbsolute(TokenReader& reader,
 }
 
 bool pathNoscheme(TokenReader& reader,
-                  std::optional<std::string>& value) {
+                  std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
@@ -1045,7 +785,7 @@ bool pathNoscheme(TokenReader& reader,
 }
 
 bool pathRootless(TokenReader& reader,
-                  std::optional<std::string>& value) {
+                  std::optional<std::string_view>& value) {
     value = std::nullopt;
     auto token = reader.save();
 
@@ -1061,61 +801,43 @@ bool pathRootless(TokenReader& reader,
 
 // Always returns true as consumes 0 elements.
 // RFC3986: zero characters.
-bool pathEmpty(TokenReader&,
-               std::optional<std::string>& value) {
-    value = "";
+bool pathEmpty(TokenReader& reader,
+               std::optional<std::string_view>& value) {
+    value = reader.extract(reader.save());
     return true;
 }
 
 bool segment(TokenReader& reader) {
-    while(pchar(reader)) {
-    }
+    reader.skip(ScanCharClass(reader.remaining(), kPcharSet));
     return true;
 }
 
 bool segmentNz(TokenReader& reader) {
-    auto token = reader.save();
-
-    size_t counter = 0;
-    while(pchar(reader)) {
-        counter += 1;
-    }
+    size_t length = ScanCharClass(reader.remaining(), kPcharSet);
 
-    if (counter < 1) {
-        reader.restore(token);
+    if (length < 1) {
         return false;
     }
 
+    reader.skip(length);
     return true;
 }
 
 bool segmentNzNc(TokenReader& reader) {
-    auto token = reader.save();
-
-    size_t counter = 0;
-    while(ConsumeUnreserved(reader) ||
-          pctEncoded(reader) ||
-          ConsumeSubDelims(reader) ||
-          reader.consume('@')) {
-        counter += 1;
-    }
+    size_t length = ScanCharClass(reader.remaining(), kSegmentNcSet);
 
-    if (counter < 1) {
-        reader.restore(token);
+    if (length < 1) {
         return false;
     }
 
+    reader.skip(length);
     return true;
 }
 
 bool pchar(TokenReader& reader) {
     auto token = reader.save();
 
-    if (ConsumeUnreserved(reader) ||
-        pctEncoded(reader) ||
-        ConsumeSubDelims(reader) ||
-        reader.consume(':') ||
-        reader.consume('@')) {
+    if (ConsumeCharClass(reader, kPchar) || pctEncoded(reader)) {
         return true;
     }
 
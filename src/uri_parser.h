@@ -4,20 +4,17 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <limits>
 
+#include "host_type.h"
+
 namespace uri {
 
 namespace __internal {
 
 class TokenReader;
 
-enum class HostType {
-    kIPLiteral = 0,
-    kIPv4 = 1,
-    kRegName = 2
-};
-
 // TODO(st235): leave only public API in header.
 
 // Entry-point tokens.
@@ -25,92 +22,92 @@ enum class HostType {
 // entire string: from the begging till the end.
 
 bool UriReference(TokenReader& reader,
-                  std::optional<std::string>& outScheme,
-                  std::optional<std::string>& outUserInfo,
-                  std::optional<std::string>& outHost,
+                  std::optional<std::string_view>& outScheme,
+                  std::optional<std::string_view>& outUserInfo,
+                  std::optional<std::string_view>& outHost,
                   std::optional<HostType>& outHostType,
-                  std::optional<std::string>& outPort,
-                  std::optional<std::string>& outPath,
-                  std::optional<std::string>& outQuery,
-                  std::optional<std::string>& outFragment);
+                  std::optional<std::string_view>& outPort,
+                  std::optional<std::string_view>& outPath,
+                  std::optional<std::string_view>& outQuery,
+                  std::optional<std::string_view>& outFragment);
 
 bool Uri(TokenReader& reader,
-         std::optional<std::string>& outScheme,
-         std::optional<std::string>& outUserInfo,
-         std::optional<std::string>& outHost,
+         std::optional<std::string_view>& outScheme,
+         std::optional<std::string_view>& outUserInfo,
+         std::optional<std::string_view>& outHost,
          std::optional<HostType>& outHostType,
-         std::optional<std::string>& outPort,
-         std::optional<std::string>& outPath,
-         std::optional<std::string>& outQuery,
-         std::optional<std::string>& outFragment);
+         std::optional<std::string_view>& outPort,
+         std::optional<std::string_view>& outPath,
+         std::optional<std::string_view>& outQuery,
+         std::optional<std::string_view>& outFragment);
 
 bool AbsoluteUri(TokenReader& reader,
-                 std::optional<std::string>& outScheme,
-                 std::optional<std::string>& outUserInfo,
-                 std::optional<std::string>& outHost,
+                 std::optional<std::string_view>& outScheme,
+                 std::optional<std::string_view>& outUserInfo,
+                 std::optional<std::string_view>& outHost,
                  std::optional<HostType>& outHostType,
-                 std::optional<std::string>& outPort,
-                 std::optional<std::string>& outPath,
-                 std::optional<std::string>& outQuery);
+                 std::optional<std::string_view>& outPort,
+                 std::optional<std::string_view>& outPath,
+                 std::optional<std::string_view>& outQuery);
 
 bool Path(TokenReader& reader,
-          std::optional<std::string>& outValue);
+          std::optional<std::string_view>& outValue);
 
 // Internal tokens (sorted by importance).
 
 bool scheme(TokenReader& reader,
-            std::optional<std::string>& outValue);
+            std::optional<std::string_view>& outValue);
 
 bool host(TokenReader& reader,
-          std::optional<std::string>& outHost,
+          std::optional<std::string_view>& outHost,
           std::optional<HostType>& outHostType);
 
 bool queryFragment(TokenReader& reader,
-                   std::optional<std::string>& outValue);
+                   std::optional<std::string_view>& outValue);
 
 bool hierPart(TokenReader& reader,
-              std::optional<std::string>& outUserInfo,
-              std::optional<std::string>& outHost,
+              std::optional<std::string_view>& outUserInfo,
+              std::optional<std::string_view>& outHost,
               std::optional<HostType>& outHostType,
-              std::optional<std::string>& outPort,
-              std::optional<std::string>& outPath);
+              std::optional<std::string_view>& outPort,
+              std::optional<std::string_view>& outPath);
 
 bool relativeRef(TokenReader& reader,
-                 std::optional<std::string>& outUserInfo,
-                 std::optional<std::string>& outHost,
+                 std::optional<std::string_view>& outUserInfo,
+                 std::optional<std::string_view>& outHost,
                  std::optional<HostType>& outHostType,
-                 std::optional<std::string>& outPort,
-                 std::optional<std::string>& outPath,
-                 std::optional<std::string>& outQuery,
-                 std::optional<std::string>& outFragment);
+                 std::optional<std::string_view>& outPort,
+                 std::optional<std::string_view>& outPath,
+                 std::optional<std::string_view>& outQuery,
+                 std::optional<std::string_view>& outFragment);
 
 bool relativePart(TokenReader& reader,
-                  std::optional<std::string>& outUserInfo,
-                  std::optional<std::string>& outHost,
+                  std::optional<std::string_view>& outUserInfo,
+                  std::optional<std::string_view>& outHost,
                   std::optional<HostType>& outHostType,
-                  std::optional<std::string>& outPort,
-                  std::optional<std::string>& outPath);
+                  std::optional<std::string_view>& outPort,
+                  std::optional<std::string_view>& outPath);
 
 bool authority(TokenReader& reader,
-               std::optional<std::string>& outUserInfo,
-               std::optional<std::string>& outHost,
+               std::optional<std::string_view>& outUserInfo,
+               std::optional<std::string_view>& outHost,
                std::optional<HostType>& outHostType,
-               std::optional<std::string>& outPort);
+               std::optional<std::string_view>& outPort);
 
 bool userInfo(TokenReader& reader,
-              std::optional<std::string>& outValue);
+              std::optional<std::string_view>& outValue);
 
 bool port(TokenReader& reader,
-          std::optional<std::string>& outValue);
+          std::optional<std::string_view>& outValue);
 
 bool IPLiteral(TokenReader& reader,
-               std::optional<std::string>& outValue);
+               std::optional<std::string_view>& outValue);
 
 bool IPv4address(TokenReader& reader,
-                 std::optional<std::string>& outValue);
+                 std::optional<std::string_view>& outValue);
 
 bool regName(TokenReader& reader,
-             std::optional<std::string>& outValue);
+             std::optional<std::string_view>& outValue);
 
 bool IPvFuture(TokenReader& reader);
 
@@ -123,19 +120,19 @@ bool ls32(TokenReader& reader);
 bool decOctet(TokenReader& reader);
 
 bool pathAbempty(TokenReader& reader,
-                 std::optional<std::string>& outValue);
+                 std::optional<std::string_view>& outValue);
 
 bool pathAbsolute(TokenReader& reader,
-                  std::optional<std::string>& outValue);
+                  std::optional<std::string_view>& outValue);
 
 bool pathNoscheme(TokenReader& reader,
-                  std::optional<std::string>& outValue);
+                  std::optional<std::string_view>& outValue);
 
 bool pathRootless(TokenReader& reader,
-                  std::optional<std::string>& outValue);
+                  std::optional<std::string_view>& outValue);
 
 bool pathEmpty(TokenReader& reader,
-               std::optional<std::string>& outValue);
+               std::optional<std::string_view>& outValue);
 
 bool segment(TokenReader& reader);
 
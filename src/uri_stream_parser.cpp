@@ -0,0 +1,186 @@
+#include "uri_stream_parser.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "uri_parser.h"
+#include "detail/uri_state_machine.h"
+
+namespace uri {
+
+UriStreamParser::UriStreamParser():
+    _machine(std::make_unique<__internal::UriStateMachine>()),
+    _chunks(),
+    _status(Status::kNeedMore) {
+    // Empty on purpose.
+}
+
+UriStreamParser::UriStreamParser(UriStreamParser&& that) noexcept = default;
+UriStreamParser& UriStreamParser::operator=(UriStreamParser&& that) noexcept = default;
+UriStreamParser::~UriStreamParser() = default;
+
+const __internal::UriStateMachine& UriStreamParser::machine() const {
+    // Only a moved-from parser has no machine.
+    assert(_machine);
+    return *_machine;
+}
+
+__internal::UriStateMachine& UriStreamParser::machine() {
+    assert(_machine);
+    return *_machine;
+}
+
+UriStreamParser::Status UriStreamParser::feed(std::string_view chunk) {
+    if (chunk.empty()) {
+        return _status;
+    }
+
+    if (_status != Status::kNeedMore) {
+        // Nothing can follow the end of the input or an error,
+        // the parsed input stays available.
+        return Status::kError;
+    }
+
+    _chunks.push_back(Chunk { machine().getPosition(), chunk });
+
+    if (!machine().feed(chunk)) {
+        _status = Status::kError;
+    }
+
+    return _status;
+}
+
+UriStreamParser::Status UriStreamParser::finish() {
+    if (_status != Status::kNeedMore) {
+        return _status;
+    }
+
+    _status = machine().finish() ? Status::kDone : Status::kError;
+    return _status;
+}
+
+size_t UriStreamParser::getErrorPosition() const {
+    return machine().getErrorPosition();
+}
+
+bool UriStreamParser::getRange(Component component, size_t& outBegin, size_t& outEnd) const {
+    if (_status != Status::kDone) {
+        return false;
+    }
+
+    __internal::UriStateMachine::Range range {};
+    switch (component) {
+        case Component::kScheme:
+            range = machine().getScheme();
+            break;
+        case Component::kUserInfo:
+            range = machine().getUserInfo();
+            break;
+        case Component::kHost:
+            range = machine().getHost();
+            break;
+        case Component::kPort:
+            range = machine().getPort();
+            break;
+        case Component::kPath:
+            range = machine().getPath();
+            break;
+        case Component::kQuery:
+            range = machine().getQuery();
+            break;
+        case Component::kFragment:
+            range = machine().getFragment();
+            break;
+    }
+
+    if (!range.present) {
+        return false;
+    }
+
+    outBegin = range.begin;
+    outEnd = range.end;
+    return true;
+}
+
+bool UriStreamParser::hasComponent(Component component) const {
+    size_t begin;
+    size_t end;
+    return getRange(component, begin, end);
+}
+
+std::optional<std::string_view> UriStreamParser::getComponentView(Component component) const {
+    size_t begin;
+    size_t end;
+    if (!getRange(component, begin, end)) {
+        return std::nullopt;
+    }
+
+    // The last chunk starting at or before the component.
+    auto chunk = std::upper_bound(_chunks.begin(), _chunks.end(), begin,
+                                  [](size_t offset, const Chunk& chunk) { return offset < chunk.offset; });
+    if (chunk == _chunks.begin()) {
+        // Only an empty component can precede the first chunk.
+        return std::string_view();
+    }
+    chunk -= 1;
+
+    if (end > chunk->offset + chunk->text.length()) {
+        return std::nullopt;
+    }
+
+    return chunk->text.substr(begin - chunk->offset, end - begin);
+}
+
+std::optional<std::string> UriStreamParser::copyComponent(Component component) const {
+    size_t begin;
+    size_t end;
+    if (!getRange(component, begin, end)) {
+        return std::nullopt;
+    }
+
+    std::string result;
+    result.reserve(end - begin);
+    for (const auto& chunk: _chunks) {
+        const size_t chunkEnd = chunk.offset + chunk.text.length();
+        if (chunkEnd <= begin || chunk.offset >= end) {
+            continue;
+        }
+
+        const size_t from = std::max(begin, chunk.offset);
+        const size_t to = std::min(end, chunkEnd);
+        result.append(chunk.text.substr(from - chunk.offset, to - from));
+    }
+    return result;
+}
+
+bool UriStreamParser::isHostIPLiteral() const {
+    const auto& hostType = machine().getHostType();
+    return _status == Status::kDone &&
+           hostType && hostType.value() == __internal::HostType::kIPLiteral;
+}
+
+std::optional<Uri> UriStreamParser::toUri(const Uri::allocator_type& allocator) const {
+    if (_status != Status::kDone) {
+        return std::nullopt;
+    }
+
+    // Offsets of Uri are stored as 32-bit integers.
+    const size_t length = machine().getPosition();
+    if (length > std::numeric_limits<uint32_t>::max()) {
+        return std::nullopt;
+    }
+
+    // The chunks are already serialised, only the ends
+    // of the components are taken from the machine.
+    Uri uri(allocator);
+    uri._buffer.reserve(length);
+    for (const auto& chunk: _chunks) {
+        uri._buffer.append(chunk.text);
+    }
+    uri.assignParsed(machine());
+
+    return uri;
+}
+
+} // namespace uri
@@ -0,0 +1,47 @@
+#include "uri_view.h"
+
+#include "detail/uri_state_machine.h"
+
+namespace uri {
+
+std::optional<UriView> UriView::parse(std::string_view input) {
+    return tryParse(input).toOptional();
+}
+
+ParseResult<UriView> UriView::tryParse(std::string_view input) {
+    __internal::UriStateMachine machine;
+
+    // The machine keeps track of the error on the failure path only,
+    // so parse can go through tryParse at no cost.
+    if (!machine.feed(input) || !machine.finish()) {
+        return ParseError { machine.getErrorCode(), machine.getErrorPosition() };
+    }
+
+    const auto extract = [input](const __internal::UriStateMachine::Range& range) {
+        return range.present
+            ? optional_string_view_t(std::string_view(input.data() + range.begin, range.length()))
+            : optional_string_view_t();
+    };
+
+    std::optional<AuthorityView> authority;
+    const auto& hostType = machine.getHostType();
+    if (hostType) {
+        bool isHostIPLiteral = hostType.value() == __internal::HostType::kIPLiteral;
+        authority = std::make_optional(AuthorityView(extract(machine.getHost()).value(),
+                                                     extract(machine.getPort()),
+                                                     extract(machine.getUserInfo()),
+                                                     /* isHostIPLiteral= */ isHostIPLiteral,
+                                                     machine.getIPv4(),
+                                                     machine.getIPv6(),
+                                                     machine.getPortNumber()));
+    }
+
+    return UriView(extract(machine.getScheme()),
+                   machine.getSchemeId(),
+                   authority,
+                   extract(machine.getPath()).value(),
+                   extract(machine.getQuery()),
+                   extract(machine.getFragment()));
+}
+
+} // namepsace uri
@@ -0,0 +1,81 @@
+#ifndef __URIC_WORK_STEALING_H__
+#define __URIC_WORK_STEALING_H__
+
+#include <atomic>
+#include <cstdint>
+
+namespace uri {
+
+namespace __internal {
+
+// A range of work items owned by one worker, packed into
+// a single atomic word as begin (high half) and end (low half).
+//
+// The owner takes items one by one from the front, other workers
+// steal the back half of the range. Both sides update the range
+// with compare-and-swap, so no locks are needed.
+class StealableRange {
+public:
+    StealableRange() noexcept:
+        _range(Pack(0, 0)) {
+        // Empty on purpose.
+    }
+
+    StealableRange(const StealableRange& that) = delete;
+    StealableRange& operator=(const StealableRange& that) = delete;
+
+    // Should only be called by the owner, and only when the range is empty.
+    void reset(uint32_t begin, uint32_t end) {
+        _range.store(Pack(begin, end), std::memory_order_release);
+    }
+
+    // Takes the first item of the range, called by the owner.
+    bool pop(uint32_t& outItem) {
+        uint64_t range = _range.load(std::memory_order_acquire);
+        while (Begin(range) < End(range)) {
+            if (_range.compare_exchange_weak(range, Pack(Begin(range) + 1, End(range)),
+                                             std::memory_order_acq_rel)) {
+                outItem = Begin(range);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Takes the back half of the range, called by other workers.
+    bool steal(uint32_t& outBegin, uint32_t& outEnd) {
+        uint64_t range = _range.load(std::memory_order_acquire);
+        while (Begin(range) < End(range)) {
+            uint32_t stolen = (End(range) - Begin(range) + 1) / 2;
+            uint32_t split = End(range) - stolen;
+            if (_range.compare_exchange_weak(range, Pack(Begin(range), split),
+                                             std::memory_order_acq_rel)) {
+                outBegin = split;
+                outEnd = End(range);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::atomic<uint64_t> _range;
+
+    static constexpr uint64_t Pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+
+    static constexpr uint32_t Begin(uint64_t range) {
+        return static_cast<uint32_t>(range >> 32);
+    }
+
+    static constexpr uint32_t End(uint64_t range) {
+        return static_cast<uint32_t>(range);
+    }
+};
+
+} // namespace __internal
+
+} // namespace uri
+
+#endif // __URIC_WORK_STEALING_H__
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "authority.h"
+#include "authority_view.h"
+
+using uri::Authority;
+using uri::AuthorityView;
+
+TEST(UriAuthorityView, ViewsWithSameContentAreEqual) {
+    AuthorityView a("www.mozila.com");
+    AuthorityView b("www.mozila.com", std::nullopt);
+    EXPECT_EQ(a, b);
+}
+
+TEST(UriAuthorityView, InvalidAuthorityIsNotParsed) {
+    EXPECT_FALSE(AuthorityView::parse("[8e4d:b902"));
+    EXPECT_FALSE(AuthorityView::parse("host:80a"));
+}
+
+TEST(UriAuthorityView, ComponentsPointIntoTheInputBuffer) {
+    const std::string input = "court@[62f:a49e:5dfa:cca7:ccd8:55fe:8806:bf69]:443";
+
+    const auto& view_opt = AuthorityView::parse(input);
+    ASSERT_TRUE(view_opt);
+
+    const auto& view = view_opt.value();
+    EXPECT_EQ(view.getUserInfo().value().data(), input.data());
+    EXPECT_EQ(view.getHost().data(), input.data() + input.find('[') + 1);
+    EXPECT_EQ(view.getPort().value().data(), input.data() + input.rfind(':') + 1);
+    EXPECT_TRUE(view.isHostIPLiteral());
+
+    EXPECT_EQ(Authority(view), Authority("62f:a49e:5dfa:cca7:ccd8:55fe:8806:bf69", "443", "court", /* isHostIPLiteral= */ true));
+}
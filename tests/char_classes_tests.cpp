@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "detail/char_classes.h"
+
+using uri::__internal::HasCharClass;
+
+namespace {
+
+bool IsOneOf(char c, const std::string& symbols) {
+    return symbols.find(c) != std::string::npos;
+}
+
+bool IsAlpha(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool IsUnreserved(char c) {
+    return IsAlpha(c) || IsDigit(c) || IsOneOf(c, "-._~");
+}
+
+bool IsSubDelims(char c) {
+    return IsOneOf(c, "!$&'()*+,;=");
+}
+
+} // namespace
+
+TEST(CharClassesTests, TableMatchesRfc3986Rules) {
+    for (int i = 0; i < 256; i++) {
+        char c = static_cast<char>(i);
+
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kAlpha), IsAlpha(c)) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kDigit), IsDigit(c)) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kHexDigit), IsDigit(c) || IsOneOf(c, "abcdefABCDEF")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kUnreserved), IsUnreserved(c)) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kSubDelims), IsSubDelims(c)) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kGenDelims), IsOneOf(c, ":/?#[]@")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kPchar), IsUnreserved(c) || IsSubDelims(c) || IsOneOf(c, ":@")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kQueryFragment), IsUnreserved(c) || IsSubDelims(c) || IsOneOf(c, ":@/?")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kScheme), IsAlpha(c) || IsDigit(c) || IsOneOf(c, "+-.")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kUserInfo), IsUnreserved(c) || IsSubDelims(c) || IsOneOf(c, ":")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kRegName), IsUnreserved(c) || IsSubDelims(c)) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kSegmentNc), IsUnreserved(c) || IsSubDelims(c) || IsOneOf(c, "@")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kPath), IsUnreserved(c) || IsSubDelims(c) || IsOneOf(c, ":@/")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kQueryParam), (IsUnreserved(c) || IsSubDelims(c) || IsOneOf(c, ":@/?")) && !IsOneOf(c, "&=+")) << i;
+        EXPECT_EQ(HasCharClass(c, uri::__internal::kLowercaseHost), (IsUnreserved(c) || IsSubDelims(c) || IsOneOf(c, ":")) && !(c >= 'A' && c <= 'Z')) << i;
+    }
+}
+
+TEST(CharClassesTests, EndOfInputAndPercentSignBelongToNoClass) {
+    EXPECT_EQ(uri::__internal::kCharClasses[0], 0);
+    EXPECT_EQ(uri::__internal::kCharClasses['%'], 0);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <utility>
+
+#include "detail/char_scanner.h"
+
+using uri::__internal::ScanCharClass;
+using uri::__internal::ScanCharClassScalar;
+
+using ValidationData = std::pair<std::string, size_t>;
+
+class CharScannerTestingFixture: public ::testing::TestWithParam<ValidationData> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        CharScannerTests,
+        CharScannerTestingFixture,
+        ::testing::Values(
+            std::make_pair("", 0),
+            std::make_pair("abc", 3),
+            std::make_pair("a/b", 1),
+            std::make_pair("%41b", 4),
+            std::make_pair("%4", 0),
+            std::make_pair("ab%", 2),
+            std::make_pair("ab%4g", 2),
+            // Blocks of 16 and 32 bytes with a stop at the very end.
+            std::make_pair("0123456789abcdef", 16),
+            std::make_pair("0123456789abcde/", 15),
+            std::make_pair("0123456789abcdef0123456789abcdef/", 32),
+            std::make_pair("0123456789abcdef0123456789abcde#x", 31),
+            // Percent-encoded triplets across the block boundary.
+            std::make_pair("0123456789abcd%41", 17),
+            std::make_pair("0123456789abcde%41", 18),
+            std::make_pair("0123456789abcde%4", 15),
+            std::make_pair("0123456789abcdef0123456789abcde%41zz", 36),
+            std::make_pair("0123456789abcdef0123456789abcde%4zzz", 31),
+            std::make_pair("0123456789abcdef0123456789abcd%%41zz", 30),
+            // Non-ASCII bytes never belong to a class.
+            std::make_pair("0123456789abcdef01234\xC3\xA9", 21)
+        )
+);
+
+TEST_P(CharScannerTestingFixture, TestThatPcharScanIsCorrect) {
+    const auto& pair = GetParam();
+
+    const auto& text = pair.first;
+    const auto& expected_length = pair.second;
+
+    EXPECT_EQ(ScanCharClass(text, uri::__internal::kPcharSet), expected_length);
+    EXPECT_EQ(ScanCharClassScalar(text, uri::__internal::kPcharSet), expected_length);
+}
+
+TEST(CharScannerTests, VectorScanMatchesScalarScan) {
+    static constexpr char kAlphabet[] = "aZF09-._~!$&'()*+,;=:@/?%#[] \x7F\x80\xFF";
+
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<size_t> symbol(0, sizeof(kAlphabet) - 2);
+    std::uniform_int_distribution<size_t> length(0, 200);
+
+    const uri::__internal::CharClassSet* sets[] = {
+        &uri::__internal::kPcharSet,
+        &uri::__internal::kQueryFragmentSet,
+        &uri::__internal::kUserInfoSet,
+        &uri::__internal::kRegNameSet,
+        &uri::__internal::kSegmentNcSet,
+        &uri::__internal::kPathSet,
+        &uri::__internal::kLowercaseHostSet
+    };
+
+    for (size_t iteration = 0; iteration < 5000; iteration++) {
+        std::string text(length(generator), 'a');
+        // Mostly valid bytes with rare stops, so scans run long.
+        for (auto& c: text) {
+            if (generator() % 16 == 0) {
+                c = kAlphabet[symbol(generator)];
+            }
+        }
+
+        for (const auto* set: sets) {
+            ASSERT_EQ(ScanCharClass(text, *set), ScanCharClassScalar(text, *set)) << text;
+        }
+    }
+}
+
+TEST(CharScannerTests, UppercaseTripletsContinueLowercaseHostScan) {
+    using uri::__internal::kLowercaseHostSet;
+
+    const std::string hosts[] = {
+        "abcdefghijklmnopqrst%2Fuvw.example.com",
+        // Triplets across the 16 and 32 bytes block boundaries.
+        "abcdefghijklmn%2Fuvw.example.com",
+        "abcdefghijklmno%2Fuvw.example.com",
+        "abcdefghijklmnopqrstuvwxyz01234%2F.example.com",
+        "abcdefghijklmnopqrstuvwxyz0123%2F.example.com"
+    };
+
+    for (const auto& host: hosts) {
+        EXPECT_EQ(ScanCharClassScalar(host, kLowercaseHostSet), host.length()) << host;
+        EXPECT_EQ(ScanCharClass(host, kLowercaseHostSet), host.length()) << host;
+    }
+
+    // Uppercase letters outside of triplets still stop the scan.
+    const std::string host = "abcdefghijklmnopqrst%2FuvW.example.com";
+    EXPECT_EQ(ScanCharClass(host, kLowercaseHostSet), ScanCharClassScalar(host, kLowercaseHostSet));
+    EXPECT_EQ(ScanCharClass(host, kLowercaseHostSet), 25);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_uri_set.h"
+#include "hashing.h"
+
+using uri::ConcurrentUriSet;
+using uri::Fingerprint;
+
+namespace {
+
+std::vector<Fingerprint> GenerateFingerprints(size_t count) {
+    std::vector<Fingerprint> fingerprints;
+    fingerprints.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        fingerprints.push_back(uri::__internal::FingerprintOf("https://example.com/" + std::to_string(i)));
+    }
+    return fingerprints;
+}
+
+} // namespace
+
+class ConcurrentUriSetConcurrencyTestingFixture: public ::testing::TestWithParam<size_t> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        ConcurrentUriSetConcurrencyTests,
+        ConcurrentUriSetConcurrencyTestingFixture,
+        ::testing::Values(2, 4, 8)
+);
+
+TEST_P(ConcurrentUriSetConcurrencyTestingFixture, EveryUriIsInsertedExactlyOnce) {
+    constexpr size_t kCount = 50000;
+    const auto& fingerprints = GenerateFingerprints(kCount);
+
+    // Small at first, so the threads insert while the set grows.
+    ConcurrentUriSet set;
+    std::vector<std::vector<size_t>> inserted(GetParam());
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < GetParam(); thread++) {
+        threads.emplace_back([&, thread]() {
+            // Every thread inserts every URI, starting from a different one.
+            for (size_t i = 0; i < kCount; i++) {
+                const size_t index = (i + thread * kCount / GetParam()) % kCount;
+                const auto result = set.insertIfAbsent(fingerprints[index], static_cast<ConcurrentUriSet::Handle>(index));
+                if (result.second) {
+                    inserted[thread].push_back(index);
+                }
+                ASSERT_EQ(result.first, index);
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    std::vector<size_t> insertions(kCount, 0);
+    for (const auto& indices: inserted) {
+        for (size_t index: indices) {
+            insertions[index]++;
+        }
+    }
+    for (size_t index = 0; index < kCount; index++) {
+        ASSERT_EQ(insertions[index], 1U) << index;
+        ASSERT_EQ(set.find(fingerprints[index]), index) << index;
+    }
+    EXPECT_EQ(set.size(), kCount);
+}
+
+TEST_P(ConcurrentUriSetConcurrencyTestingFixture, ReadersFindUrisWhileTheSetGrows) {
+    constexpr size_t kCount = 50000;
+    const auto& fingerprints = GenerateFingerprints(kCount);
+
+    ConcurrentUriSet set;
+    std::atomic<size_t> published(0);
+    std::atomic<bool> lost(false);
+
+    std::vector<std::thread> readers;
+    for (size_t reader = 1; reader < GetParam(); reader++) {
+        readers.emplace_back([&]() {
+            while (published.load(std::memory_order_acquire) < kCount) {
+                // Everything inserted before is found, whatever table it is in.
+                const size_t count = published.load(std::memory_order_acquire);
+                for (size_t index = (count > 64) ? count - 64 : 0; index < count; index++) {
+                    if (set.find(fingerprints[index]) != index) {
+                        lost.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    }
+
+    for (size_t index = 0; index < kCount; index++) {
+        set.insertIfAbsent(fingerprints[index], static_cast<ConcurrentUriSet::Handle>(index));
+        published.store(index + 1, std::memory_order_release);
+    }
+    for (auto& reader: readers) {
+        reader.join();
+    }
+
+    EXPECT_FALSE(lost.load());
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "concurrent_uri_set.h"
+#include "hashing.h"
+#include "uri.h"
+
+using uri::ConcurrentUriSet;
+using uri::Fingerprint;
+using uri::Uri;
+
+namespace {
+
+Fingerprint FingerprintOf(size_t i) {
+    return uri::__internal::FingerprintOf("https://example.com/" + std::to_string(i));
+}
+
+} // namespace
+
+TEST(ConcurrentUriSetTests, EmptySetFindsNothing) {
+    const ConcurrentUriSet set;
+    EXPECT_EQ(set.size(), 0);
+    EXPECT_FALSE(set.find(Uri::parse("http://example.com/").value()));
+}
+
+TEST(ConcurrentUriSetTests, EquivalentUrisAreInsertedOnce) {
+    ConcurrentUriSet set;
+
+    const auto inserted = set.insertIfAbsent(Uri::parse("http://example.com/~user").value(), 1);
+    EXPECT_EQ(inserted.first, 1U);
+    EXPECT_TRUE(inserted.second);
+
+    const auto equivalent = set.insertIfAbsent(Uri::parse("HTTP://Example.com:80/%7Euser").value(), 2);
+    EXPECT_EQ(equivalent.first, 1U);
+    EXPECT_FALSE(equivalent.second);
+
+    const auto other = set.insertIfAbsent(Uri::parse("http://example.com/~other").value(), 3);
+    EXPECT_EQ(other.first, 3U);
+    EXPECT_TRUE(other.second);
+
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_EQ(set.find(Uri::parse("http://example.com/a/../~user").value()), 1U);
+    EXPECT_EQ(set.find(Uri::parse("http://example.com/~other").value()), 3U);
+    EXPECT_FALSE(set.find(Uri::parse("http://example.com/~else").value()));
+}
+
+TEST(ConcurrentUriSetTests, SetGrowsAndKeepsEveryUri) {
+    // Starts from the smallest table and grows many times.
+    ConcurrentUriSet set;
+
+    constexpr size_t kCount = 100000;
+    for (size_t i = 0; i < kCount; i++) {
+        const auto result = set.insertIfAbsent(FingerprintOf(i), static_cast<ConcurrentUriSet::Handle>(i));
+        ASSERT_TRUE(result.second) << i;
+        ASSERT_EQ(result.first, i);
+    }
+    EXPECT_EQ(set.size(), kCount);
+
+    for (size_t i = 0; i < kCount; i++) {
+        ASSERT_EQ(set.find(FingerprintOf(i)), i) << i;
+        ASSERT_FALSE(set.insertIfAbsent(FingerprintOf(i), 0).second) << i;
+    }
+    EXPECT_FALSE(set.find(FingerprintOf(kCount)));
+    EXPECT_EQ(set.size(), kCount);
+}
+
+TEST(ConcurrentUriSetTests, FingerprintsWithTheSameSlotAreToldApart) {
+    ConcurrentUriSet set(4);
+
+    // Same probing start and tag, only the rest differs.
+    const Fingerprint first { 7, 0 };
+    const Fingerprint second { 7, 1 };
+    const Fingerprint third { 7 + 1024, 0 };
+    EXPECT_TRUE(set.insertIfAbsent(first, 1).second);
+    EXPECT_TRUE(set.insertIfAbsent(second, 2).second);
+    EXPECT_TRUE(set.insertIfAbsent(third, 3).second);
+
+    EXPECT_EQ(set.find(first), 1U);
+    EXPECT_EQ(set.find(second), 2U);
+    EXPECT_EQ(set.find(third), 3U);
+    EXPECT_FALSE(set.find(Fingerprint { 7, 2 }));
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "authority.h"
+#include "hashing.h"
+#include "uri.h"
+#include "url.h"
+
+using uri::Authority;
+using uri::Fingerprint;
+using uri::Uri;
+using uri::Url;
+using uri::__internal::FingerprintOf;
+using uri::__internal::Hasher;
+using uri::__internal::HashOf;
+
+TEST(HasherTests, HashDoesNotDependOnHowBytesAreSplit) {
+    const std::string_view text = "https://user@example.com:8443/a/b/c?query=value#fragment";
+
+    for (size_t first = 0; first <= text.length(); first++) {
+        for (size_t second = first; second <= text.length(); second += 3) {
+            Hasher hasher;
+            hasher.update(text.substr(0, first));
+            hasher.update(text.substr(first, second - first));
+            hasher.update(text.substr(second));
+
+            EXPECT_EQ(hasher.fingerprint(), FingerprintOf(text));
+            EXPECT_EQ(hasher.hash(), HashOf(text));
+        }
+    }
+}
+
+TEST(HasherTests, HashTellsApartLengthsAndBytes) {
+    std::unordered_set<uint64_t> hashes;
+    std::unordered_set<Fingerprint> fingerprints;
+
+    std::string text;
+    for (size_t i = 0; i < 64; i++) {
+        EXPECT_TRUE(hashes.insert(HashOf(text)).second) << text;
+        EXPECT_TRUE(fingerprints.insert(FingerprintOf(text)).second) << text;
+
+        // Zero bytes must count as well, e.g. "" and "\0".
+        text.push_back(static_cast<char>(i % 3));
+    }
+
+    EXPECT_NE(HashOf("http://a/b"), HashOf("http://a/c"));
+    EXPECT_NE(HashOf("http://example.com/a"), HashOf("http://example.com/b"));
+}
+
+TEST(HasherTests, EmptyHashersAreEqual) {
+    Hasher hasher;
+    hasher.update("");
+    EXPECT_EQ(hasher.fingerprint(), Hasher().fingerprint());
+    EXPECT_EQ(hasher.fingerprint(), FingerprintOf(""));
+}
+
+class UriHashingTestingFixture: public ::testing::TestWithParam<std::pair<std::string, std::string>> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        UriHashingTests,
+        UriHashingTestingFixture,
+        ::testing::Values(
+            std::make_pair("http://example.com/a/b", "HTTP://EXAMPLE.COM/a/b"),
+            std::make_pair("http://example.com/~user", "http://example.com/%7Euser"),
+            std::make_pair("http://example.com/%C3%A9", "http://example.com/%c3%a9"),
+            std::make_pair("http://example.com/", "http://example.com:80"),
+            std::make_pair("http://example.com/a/c", "http://example.com/a/./b/../c"),
+            std::make_pair("https://[2001:db8::1]/", "https://[2001:DB8::1]:443/"),
+            std::make_pair("foo://example.com", "foo://Example.com:"),
+            std::make_pair("http:/.//a", "http:/.//a"),
+            std::make_pair("a/~/../b", "a/%7E/../b")
+        )
+);
+
+TEST_P(UriHashingTestingFixture, EquivalentUrisHaveEqualNormalisedHashes) {
+    const auto& pair = GetParam();
+
+    const auto normal = Uri::parse(pair.first);
+    const auto equivalent = Uri::parse(pair.second);
+    ASSERT_TRUE(normal);
+    ASSERT_TRUE(equivalent);
+
+    EXPECT_EQ(normal->getNormalisedHash(), equivalent->getNormalisedHash());
+    EXPECT_EQ(normal->getNormalisedFingerprint(), equivalent->getNormalisedFingerprint());
+
+    EXPECT_EQ(normal->getNormalisedHash(), normal->getHash());
+    EXPECT_EQ(normal->getNormalisedFingerprint(), normal->getFingerprint());
+    if (pair.first != pair.second) {
+        EXPECT_NE(normal->getHash(), equivalent->getHash());
+    }
+}
+
+TEST(UriHashingTests, HashIsTheHashOfTheSerialisedUri) {
+    const auto uri = Uri::parse("https://user@example.com:8443/a?q=1#top");
+    ASSERT_TRUE(uri);
+
+    EXPECT_EQ(uri->getHash(), HashOf(uri->toString()));
+    EXPECT_EQ(uri->getFingerprint(), FingerprintOf(uri->toString()));
+
+    const Uri built("https", Authority("example.com", "8443", "user"), "/a", "q=1", "top");
+    EXPECT_EQ(built, uri.value());
+    EXPECT_EQ(built.getHash(), uri->getHash());
+}
+
+TEST(UriHashingTests, CopiesKeepTheHash) {
+    const auto uri = Uri::parse("http://example.com/a");
+    ASSERT_TRUE(uri);
+
+    std::pmr::monotonic_buffer_resource resource;
+    const Uri copy(uri.value(), Uri::allocator_type(&resource));
+    EXPECT_EQ(copy.getHash(), uri->getHash());
+
+    Uri moved(Uri(uri.value()), Uri::allocator_type(&resource));
+    EXPECT_EQ(moved.getHash(), uri->getHash());
+}
+
+TEST(UriHashingTests, DifferentBoundariesAreStillUnequal) {
+    // The same text, but "a:b" is a scheme and a path in one
+    // and a path only in the other.
+    const auto with_scheme = Uri::parse("a:b");
+    const Uri path_only("a:b");
+    ASSERT_TRUE(with_scheme);
+
+    EXPECT_EQ(with_scheme->getHash(), path_only.getHash());
+    EXPECT_NE(with_scheme.value(), path_only);
+}
+
+TEST(UriHashingTests, UrisCanBeKeysOfUnorderedContainers) {
+    std::unordered_set<Uri> uris;
+    for (const auto& input: { "http://a/b", "http://a/c", "http://a/b", "HTTP://a/b" }) {
+        uris.insert(Uri::parse(input).value());
+    }
+    EXPECT_EQ(uris.size(), 3);
+    EXPECT_EQ(uris.count(Uri::parse("http://a/c").value()), 1);
+}
+
+TEST(AuthorityHashingTests, AuthoritiesCanBeKeysOfUnorderedContainers) {
+    const Authority authority("example.com", "8080", "user");
+    EXPECT_EQ(authority.getHash(), HashOf("user@example.com:8080"));
+    EXPECT_EQ(Authority("::1", std::nullopt, std::nullopt, true).getHash(), HashOf("[::1]"));
+
+    std::unordered_set<Authority> authorities;
+    authorities.insert(authority);
+    authorities.insert(Authority::parse("user@example.com:8080").value());
+    authorities.insert(Authority("example.com", "8080"));
+    EXPECT_EQ(authorities.size(), 2);
+}
+
+TEST(UrlHashingTests, UrlsCanBeKeysOfUnorderedContainers) {
+    const auto url = Url::parse("https://example.com/search?q=uri");
+    ASSERT_TRUE(url);
+    EXPECT_EQ(url->getHash(), Uri::parse("https://example.com/search?q=uri")->getHash());
+
+    std::unordered_set<Url> urls;
+    urls.insert(Url(url.value()));
+    urls.insert(Url::parse("https://example.com/search?q=uri").value());
+    urls.insert(Url::parse("https://example.com/search?q=url").value());
+    EXPECT_EQ(urls.size(), 2);
+}
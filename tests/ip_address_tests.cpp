@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "authority.h"
+#include "ip_address.h"
+#include "uri.h"
+#include "uri_view.h"
+
+using uri::IPv6Address;
+
+using DecodingData = std::pair<std::string, IPv6Address>;
+
+class IPv6AddressDecodingTestingFixture: public ::testing::TestWithParam<DecodingData> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        IPv6AddressDecodingTests,
+        IPv6AddressDecodingTestingFixture,
+        ::testing::Values(
+            std::make_pair("::", IPv6Address {}),
+            std::make_pair("::1", IPv6Address { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 }),
+            std::make_pair("1::", IPv6Address { 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }),
+            std::make_pair("2001:DB8::ff00:42:8329", IPv6Address { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0xff, 0x00, 0, 0x42, 0x83, 0x29 }),
+            std::make_pair("2001:0db8:0000:0000:0000:ff00:0042:8329", IPv6Address { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0xff, 0x00, 0, 0x42, 0x83, 0x29 }),
+            std::make_pair("1:2:3:4:5:6:7:8", IPv6Address { 0, 1, 0, 2, 0, 3, 0, 4, 0, 5, 0, 6, 0, 7, 0, 8 }),
+            std::make_pair("1:2:3::6:7:8", IPv6Address { 0, 1, 0, 2, 0, 3, 0, 0, 0, 0, 0, 6, 0, 7, 0, 8 }),
+            std::make_pair("::ffff:192.0.2.128", IPv6Address { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 192, 0, 2, 128 }),
+            std::make_pair("1:2:3:4:5:6:10.0.0.1", IPv6Address { 0, 1, 0, 2, 0, 3, 0, 4, 0, 5, 0, 6, 10, 0, 0, 1 }),
+            std::make_pair("64:ff9b::255.255.255.255", IPv6Address { 0, 0x64, 0xff, 0x9b, 0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255 })
+        )
+);
+
+TEST_P(IPv6AddressDecodingTestingFixture, TestThatAddressIsDecoded) {
+    const auto& pair = GetParam();
+
+    const auto& address = uri::ParseIPv6Address(pair.first);
+
+    ASSERT_TRUE(address);
+    EXPECT_EQ(address.value(), pair.second);
+}
+
+class IPv6AddressRejectionTestingFixture: public ::testing::TestWithParam<std::string> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        IPv6AddressRejectionTests,
+        IPv6AddressRejectionTestingFixture,
+        ::testing::Values(
+            "",
+            ":",
+            ":::",
+            "1:2:3:4:5:6:7",
+            "1:2:3:4:5:6:7:8:9",
+            "1::2::3",
+            "12345::",
+            ":1::",
+            "1:2:3:4:5:6:7:1.2.3.4",
+            "::256.0.0.1",
+            "::1.2.3",
+            "v1.fe",
+            "g::"
+        )
+);
+
+TEST_P(IPv6AddressRejectionTestingFixture, TestThatInvalidAddressIsRejected) {
+    EXPECT_FALSE(uri::ParseIPv6Address(GetParam()));
+}
+
+using CanonicalData = std::pair<std::string, std::string>;
+
+class IPv6AddressCanonicalTextTestingFixture: public ::testing::TestWithParam<CanonicalData> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        IPv6AddressCanonicalTextTests,
+        IPv6AddressCanonicalTextTestingFixture,
+        ::testing::Values(
+            // Examples of RFC5952.
+            std::make_pair("2001:db8:0:0:1:0:0:1", "2001:db8::1:0:0:1"),
+            std::make_pair("2001:0db8:0:0:1:0:0:1", "2001:db8::1:0:0:1"),
+            std::make_pair("2001:db8::1:0:0:1", "2001:db8::1:0:0:1"),
+            std::make_pair("2001:db8::0:1:0:0:1", "2001:db8::1:0:0:1"),
+            std::make_pair("2001:0db8::1:0:0:1", "2001:db8::1:0:0:1"),
+            std::make_pair("2001:db8:0:0:1::1", "2001:db8::1:0:0:1"),
+            std::make_pair("2001:DB8:0:0:1::1", "2001:db8::1:0:0:1"),
+            std::make_pair("2001:db8:aaaa:bbbb:cccc:dddd:eeee:0001", "2001:db8:aaaa:bbbb:cccc:dddd:eeee:1"),
+            std::make_pair("2001:db8::0:1", "2001:db8::1"),
+            std::make_pair("2001:db8:0:1:1:1:1:1", "2001:db8:0:1:1:1:1:1"),
+            std::make_pair("2001:0:0:1:0:0:0:1", "2001:0:0:1::1"),
+            std::make_pair("0:0:0:0:0:0:0:0", "::"),
+            std::make_pair("0:0:0:0:0:0:0:1", "::1"),
+            std::make_pair("1:0:0:0:0:0:0:0", "1::"),
+            std::make_pair("::ffff:c000:0280", "::ffff:192.0.2.128"),
+            std::make_pair("::1.2.3.4", "::102:304")
+        )
+);
+
+TEST_P(IPv6AddressCanonicalTextTestingFixture, TestThatCanonicalTextIsCorrect) {
+    const auto& pair = GetParam();
+
+    EXPECT_EQ(uri::ToString(uri::ParseIPv6Address(pair.first).value()), pair.second);
+}
+
+TEST(IPv6AddressTests, AuthorityKeepsDecodedAddress) {
+    const auto authority = uri::Authority::parse("[2001:DB8:0:0::1]:443").value();
+
+    EXPECT_EQ(authority.getHost(), "2001:DB8:0:0::1");
+    EXPECT_EQ(authority.getIPv6(), uri::ParseIPv6Address("2001:db8::1"));
+    EXPECT_EQ(authority.getCanonicalIPv6().value(), "2001:db8::1");
+}
+
+TEST(IPv6AddressTests, AuthorityWithoutIPv6HasNoAddress) {
+    EXPECT_FALSE(uri::Authority::parse("[v1.fe]").value().getIPv6());
+    EXPECT_FALSE(uri::Authority::parse("127.0.0.1").value().getIPv6());
+    EXPECT_FALSE(uri::Authority::parse("example.com").value().getCanonicalIPv6());
+}
+
+using IPv4DecodingData = std::pair<std::string, std::optional<uri::IPv4Address>>;
+
+class IPv4AddressDecodingTestingFixture: public ::testing::TestWithParam<IPv4DecodingData> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        IPv4AddressDecodingTests,
+        IPv4AddressDecodingTestingFixture,
+        ::testing::Values(
+            std::make_pair("0.0.0.0", std::make_optional<uri::IPv4Address>(0)),
+            std::make_pair("127.0.0.1", std::make_optional<uri::IPv4Address>(0x7F000001)),
+            std::make_pair("192.168.1.254", std::make_optional<uri::IPv4Address>(0xC0A801FE)),
+            std::make_pair("255.255.255.255", std::make_optional<uri::IPv4Address>(0xFFFFFFFF)),
+            std::make_pair("", std::nullopt),
+            std::make_pair("1.2.3", std::nullopt),
+            std::make_pair("1.2.3.4.", std::nullopt),
+            std::make_pair("1.2.3.256", std::nullopt),
+            std::make_pair("01.2.3.4", std::nullopt),
+            std::make_pair("1.2.3.1000", std::nullopt),
+            std::make_pair("1.2.3.a", std::nullopt)
+        )
+);
+
+TEST_P(IPv4AddressDecodingTestingFixture, TestThatAddressIsDecoded) {
+    const auto& pair = GetParam();
+
+    EXPECT_EQ(uri::ParseIPv4Address(pair.first), pair.second);
+}
+
+using PortDecodingData = std::pair<std::string, std::optional<uint16_t>>;
+
+class PortNumberDecodingTestingFixture: public ::testing::TestWithParam<PortDecodingData> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        PortNumberDecodingTests,
+        PortNumberDecodingTestingFixture,
+        ::testing::Values(
+            std::make_pair("0", std::make_optional<uint16_t>(0)),
+            std::make_pair("80", std::make_optional<uint16_t>(80)),
+            std::make_pair("0080", std::make_optional<uint16_t>(80)),
+            std::make_pair("65535", std::make_optional<uint16_t>(65535)),
+            std::make_pair("000000000000443", std::make_optional<uint16_t>(443)),
+            std::make_pair("", std::nullopt),
+            std::make_pair("65536", std::nullopt),
+            std::make_pair("99999999999999999999", std::nullopt),
+            std::make_pair("8a", std::nullopt)
+        )
+);
+
+TEST_P(PortNumberDecodingTestingFixture, TestThatPortIsDecoded) {
+    const auto& pair = GetParam();
+
+    EXPECT_EQ(uri::ParsePortNumber(pair.first), pair.second);
+}
+
+TEST(IPv4AddressTests, AuthorityKeepsDecodedAddressAndPort) {
+    const auto authority = uri::Authority::parse("user@10.0.0.1:8080").value();
+
+    EXPECT_EQ(authority.getIPv4(), std::make_optional<uri::IPv4Address>(0x0A000001));
+    EXPECT_EQ(authority.getPortNumber(), std::make_optional<uint16_t>(8080));
+}
+
+TEST(IPv4AddressTests, AuthorityWithoutIPv4HasNoAddress) {
+    EXPECT_FALSE(uri::Authority::parse("10.0.0.256").value().getIPv4());
+    EXPECT_FALSE(uri::Authority::parse("[::1]").value().getIPv4());
+    EXPECT_FALSE(uri::Authority::parse("example.com:").value().getPortNumber());
+    EXPECT_FALSE(uri::Authority::parse("example.com:70000").value().getPortNumber());
+    EXPECT_FALSE(uri::Authority::parse("example.com").value().getPortNumber());
+}
+
+class ParsedAuthorityDecodingTestingFixture: public ::testing::TestWithParam<std::string> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        ParsedAuthorityDecodingTests,
+        ParsedAuthorityDecodingTestingFixture,
+        ::testing::Values(
+            "http://user@10.0.0.1:8080/",
+            "//10.0.0.1:/",
+            "//10.0.0.256:65536",
+            "//12:34@10.0.0.1",
+            "//12:34@example.com:0080",
+            "//10.0.0.1",
+            "http://[2001:DB8::1]:443/a",
+            "//[::ffff:1.2.3.4]",
+            "//[v7.a:b]:8",
+            "//example.com:99999999999999999999",
+            "mailto:user@example.com"
+        )
+);
+
+TEST_P(ParsedAuthorityDecodingTestingFixture, TestThatParsedValuesMatchDecodedText) {
+    const auto& text = GetParam();
+
+    const auto uri = uri::Uri::parse(text);
+    ASSERT_TRUE(uri);
+    const auto view = uri::UriView::parse(text);
+    ASSERT_TRUE(view);
+    EXPECT_EQ(uri->getAuthority().has_value(), view->getAuthority().has_value());
+    if (!uri->getAuthority()) {
+        return;
+    }
+
+    // Values decoded by the parser, compared to the ones decoded from the text.
+    for (const auto& parsed: { uri->getAuthority().value(), view->getAuthority().value() }) {
+        const uri::AuthorityView text_only(parsed.getHost(), parsed.getPort(),
+                                           parsed.getUserInfo(), parsed.isHostIPLiteral());
+        EXPECT_EQ(parsed.getIPv4(), text_only.getIPv4());
+        EXPECT_EQ(parsed.getIPv6(), text_only.getIPv6());
+        EXPECT_EQ(parsed.getPortNumber(), text_only.getPortNumber());
+    }
+}
+
+TEST(IPv4AddressTests, ParsedUriKeepsDecodedAddressAndPort) {
+    const auto authority = uri::Uri::parse("http://user@10.0.0.1:8080/").value().getAuthority().value();
+
+    EXPECT_EQ(authority.getIPv4(), std::make_optional<uri::IPv4Address>(0x0A000001));
+    EXPECT_FALSE(authority.getIPv6());
+    EXPECT_EQ(authority.getPortNumber(), std::make_optional<uint16_t>(8080));
+}
+
+TEST(IPv6AddressTests, ParsedUriKeepsDecodedAddress) {
+    const auto authority = uri::Uri::parse("http://[2001:db8::1]/").value().getAuthority().value();
+
+    const IPv6Address expected = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 };
+    EXPECT_EQ(authority.getIPv6(), std::make_optional(expected));
+    EXPECT_FALSE(authority.getIPv4());
+    EXPECT_FALSE(authority.getPortNumber());
+}
+
+TEST(IPv4AddressTests, BuiltUriKeepsDecodedAddressAndPort) {
+    const uri::Uri built("http", uri::Authority("10.0.0.1", "80"), "/");
+    EXPECT_EQ(built.getAuthority()->getIPv4(), std::make_optional<uri::IPv4Address>(0x0A000001));
+    EXPECT_EQ(built.getAuthority()->getPortNumber(), std::make_optional<uint16_t>(80));
+
+    // Decoding may turn a reg-name into an IPv4 address.
+    const uri::Uri normalised = uri::Uri::parse("http://%31.2.3.4:8080/").value().normalised();
+    EXPECT_EQ(normalised.getAuthority()->getIPv4(), std::make_optional<uri::IPv4Address>(0x01020304));
+    EXPECT_EQ(normalised.getAuthority()->getPortNumber(), std::make_optional<uint16_t>(8080));
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "parse_result.h"
+#include "uri.h"
+#include "uri_view.h"
+
+using uri::ParseError;
+using uri::ParseErrorCode;
+using uri::Uri;
+using uri::UriView;
+
+using ParseErrorData = std::tuple<std::string, ParseErrorCode, size_t>;
+
+class ParseErrorTestingFixture: public ::testing::TestWithParam<ParseErrorData> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        ParseErrorTests,
+        ParseErrorTestingFixture,
+        ::testing::Values(
+            std::make_tuple(":website.com", ParseErrorCode::kScheme, 0),
+            std::make_tuple("//user:pass", ParseErrorCode::kUserInfo, 11),
+            std::make_tuple("http://exa mple.com", ParseErrorCode::kHost, 10),
+            std::make_tuple("http://[::1/path", ParseErrorCode::kIPLiteral, 11),
+            std::make_tuple("http://[::1", ParseErrorCode::kIPLiteral, 11),
+            std::make_tuple("http://[1:2:3:4:5:6:7:8:9]", ParseErrorCode::kIPLiteral, 23),
+            std::make_tuple("http://[::1]x", ParseErrorCode::kIPLiteral, 12),
+            std::make_tuple("http://host:8[", ParseErrorCode::kPort, 13),
+            std::make_tuple("http://[::1]:8a", ParseErrorCode::kPort, 14),
+            std::make_tuple("http://host/a b", ParseErrorCode::kPath, 13),
+            std::make_tuple("1a:b", ParseErrorCode::kPath, 2),
+            std::make_tuple("http://host/?a b", ParseErrorCode::kQuery, 14),
+            std::make_tuple("a#b#c", ParseErrorCode::kFragment, 3),
+            std::make_tuple("http://host/%zz", ParseErrorCode::kPctEncoded, 13),
+            std::make_tuple("http://host/a%4", ParseErrorCode::kPctEncoded, 15)
+        )
+);
+
+TEST_P(ParseErrorTestingFixture, TestThatErrorIsReported) {
+    const auto& [input, code, position] = GetParam();
+
+    const auto& view_result = UriView::tryParse(input);
+    ASSERT_FALSE(view_result);
+    EXPECT_EQ(view_result.getError(), (ParseError { code, position }));
+
+    const auto& uri_result = Uri::tryParse(input);
+    ASSERT_FALSE(uri_result);
+    EXPECT_EQ(uri_result.getError(), (ParseError { code, position }));
+}
+
+class ParseResultTestingFixture: public ::testing::TestWithParam<std::string> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        ParseResultTests,
+        ParseResultTestingFixture,
+        ::testing::Values(
+            "",
+            "https://user@example.com:8080/a/b?q=1#f",
+            "//[v7.a:b]",
+            "//192.168.0.1/",
+            "mailto:user@example.com",
+            "../relative?x"
+        )
+);
+
+TEST_P(ParseResultTestingFixture, TestThatValidInputMatchesParse) {
+    const auto& input = GetParam();
+
+    const auto& view_result = UriView::tryParse(input);
+    ASSERT_TRUE(view_result);
+    EXPECT_EQ(view_result.toOptional(), UriView::parse(input));
+
+    const auto& uri_result = Uri::tryParse(input);
+    ASSERT_TRUE(uri_result);
+    EXPECT_EQ(uri_result.value(), Uri::parse(input).value());
+}
+
+TEST(ParseResultTests, ErrorIsPrintable) {
+    std::ostringstream stream;
+    stream << ParseError { ParseErrorCode::kPort, 14 };
+    EXPECT_EQ(stream.str(), "port at 14");
+}
+
+TEST(ParseResultTests, TooLongInputIsPrintable) {
+    std::ostringstream stream;
+    stream << ParseError { ParseErrorCode::kTooLong, 4294967295 };
+    EXPECT_EQ(stream.str(), "too long at 4294967295");
+}
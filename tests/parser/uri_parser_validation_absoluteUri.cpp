@@ -83,13 +83,13 @@ TEST_P(UriParserAbsoluteUriTestingFixture, TestThatAbsoluteUriParsingIsCorrect)
     const auto& expected_path = authority_payload.expected_path;
     const auto& expected_query = authority_payload.expected_query;
 
-    std::optional<std::string> parsed_scheme;
-    std::optional<std::string> parsed_userInfo;
-    std::optional<std::string> parsed_host;
+    std::optional<std::string_view> parsed_scheme;
+    std::optional<std::string_view> parsed_userInfo;
+    std::optional<std::string_view> parsed_host;
     std::optional<uri::__internal::HostType> parsed_host_type;
-    std::optional<std::string> parsed_port;
-    std::optional<std::string> parsed_path;
-    std::optional<std::string> parsed_query;
+    std::optional<std::string_view> parsed_port;
+    std::optional<std::string_view> parsed_path;
+    std::optional<std::string_view> parsed_query;
     uri::__internal::TokenReader reader(original_text);
 
     EXPECT_EQ(
@@ -62,10 +62,10 @@ TEST_P(UriParserAuthorityTestingFixture, TestThatAuthorityParsingIsCorrect) {
     const auto& expected_host_type = authority_payload.expected_host_type;
     const auto& expected_port = authority_payload.expected_port;
 
-    std::optional<std::string> parsed_userInfo;
-    std::optional<std::string> parsed_host;
+    std::optional<std::string_view> parsed_userInfo;
+    std::optional<std::string_view> parsed_host;
     std::optional<uri::__internal::HostType> parsed_host_type;
-    std::optional<std::string> parsed_port;
+    std::optional<std::string_view> parsed_port;
     uri::__internal::TokenReader reader(original_text);
 
     EXPECT_EQ(
@@ -48,7 +48,10 @@ INSTANTIATE_TEST_SUITE_P(
             ParserTestPayload::success("v."),
             ParserTestPayload::success("v1."),
             ParserTestPayload::success("v.12345"),
-            ParserTestPayload::success("localhost")
+            ParserTestPayload::success("localhost"),
+            ParserTestPayload::success("1.2.3.4.example"),
+            ParserTestPayload::success("1.2.3.256"),
+            ParserTestPayload::success("1.2.3.04")
         )
 );
 
@@ -59,7 +62,7 @@ TEST_P(UriParserHostTestingFixture, TestThatHostParsingIsCorrect) {
     const auto& expected_status = validation_data.expected_status;
     const auto& expected_text = validation_data.expected_text;
 
-    std::optional<std::string> parsed_host;
+    std::optional<std::string_view> parsed_host;
     std::optional<uri::__internal::HostType> parsed_host_type;
     uri::__internal::TokenReader reader(original_text);
 
@@ -46,7 +46,7 @@ TEST_P(UriParserPathTestingFixture, TestThatPathParsingIsCorrect) {
     const auto& expected_status = validation_data.expected_status;
     const auto& expected_text = validation_data.expected_text;
 
-    std::optional<std::string> parsed_value;
+    std::optional<std::string_view> parsed_value;
     uri::__internal::TokenReader reader(original_text);
 
     EXPECT_EQ(uri::__internal::Path(reader, parsed_value), expected_status);
@@ -65,11 +65,11 @@ TEST_P(UriParserRelativePartTestingFixture, TestThatRelativePartParsingIsCorrect
     const auto& expected_port = authority_payload.expected_port;
     const auto& expected_path = authority_payload.expected_path;
 
-    std::optional<std::string> parsed_userInfo;
-    std::optional<std::string> parsed_host;
+    std::optional<std::string_view> parsed_userInfo;
+    std::optional<std::string_view> parsed_host;
     std::optional<uri::__internal::HostType> parsed_host_type;
-    std::optional<std::string> parsed_port;
-    std::optional<std::string> parsed_path;
+    std::optional<std::string_view> parsed_port;
+    std::optional<std::string_view> parsed_path;
     uri::__internal::TokenReader reader(original_text);
 
     EXPECT_EQ(
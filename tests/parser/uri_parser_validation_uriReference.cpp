@@ -218,7 +218,42 @@ INSTANTIATE_TEST_SUITE_P(
 
             UriTestPayload::success("main/explore/categories/posts/list?id=123")
                 .expectPath("main/explore/categories/posts/list")
-                .expectQuery("id=123")
+                .expectQuery("id=123"),
+
+            // Ambiguous prefixes: decided only by a later byte.
+            UriTestPayload::success("a+b.c/d:e")
+                .expectPath("a+b.c/d:e"),
+
+            UriTestPayload::success("a+b.c:d")
+                .expectScheme("a+b.c")
+                .expectPath("d"),
+
+            UriTestPayload::success("//user:123@host:80")
+                .expectUserInfo("user:123")
+                .expectHost("host")
+                .expectPort("80")
+                .expectPath(""),
+
+            UriTestPayload::success("//user:123")
+                .expectHost("user")
+                .expectPort("123")
+                .expectPath(""),
+
+            // IPv4address should match the entire host.
+            UriTestPayload::success("http://1.2.3.4.example/")
+                .expectScheme("http")
+                .expectHost("1.2.3.4.example")
+                .expectPath("/"),
+
+            UriTestPayload::success("http://1.2.3.256")
+                .expectScheme("http")
+                .expectHost("1.2.3.256")
+                .expectPath(""),
+
+            UriTestPayload::error("//user:pass"),
+            UriTestPayload::error("a:b:c@d:e%4"),
+            UriTestPayload::error("1a:b"),
+            UriTestPayload::error("//[::1")
         )
 );
 
@@ -237,14 +272,14 @@ TEST_P(UriParserUriReferenceTestingFixture, TestThatUriParsingIsCorrect) {
     const auto& expected_query = authority_payload.expected_query;
     const auto& expected_fragment = authority_payload.expected_fragment;
 
-    std::optional<std::string> parsed_scheme;
-    std::optional<std::string> parsed_userInfo;
-    std::optional<std::string> parsed_host;
+    std::optional<std::string_view> parsed_scheme;
+    std::optional<std::string_view> parsed_userInfo;
+    std::optional<std::string_view> parsed_host;
     std::optional<uri::__internal::HostType> parsed_host_type;
-    std::optional<std::string> parsed_port;
-    std::optional<std::string> parsed_path;
-    std::optional<std::string> parsed_query;
-    std::optional<std::string> parsed_fragment;
+    std::optional<std::string_view> parsed_port;
+    std::optional<std::string_view> parsed_path;
+    std::optional<std::string_view> parsed_query;
+    std::optional<std::string_view> parsed_fragment;
     uri::__internal::TokenReader reader(original_text);
 
     EXPECT_EQ(
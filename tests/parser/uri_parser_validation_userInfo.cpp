@@ -34,7 +34,7 @@ TEST_P(UriParserUserInfoTestingFixture, TestThatUserInfoParsingIsCorrect) {
     const auto& expected_status = validation_data.expected_status;
     const auto& expected_text = validation_data.expected_text;
 
-    std::optional<std::string> parsed_value;
+    std::optional<std::string_view> parsed_value;
     uri::__internal::TokenReader reader(original_text);
 
     EXPECT_EQ(uri::__internal::userInfo(reader, parsed_value) && !reader.hasNext(), expected_status);
@@ -31,7 +31,11 @@ INSTANTIATE_TEST_SUITE_P(
             std::make_pair("<generic>", "%3Cgeneric%3E"),
 
             // Capitalisation of PCT Encoded symbols.
-            std::make_pair("ab %5b %8E %aa", "ab%20%5B%20%8E%20%AA")
+            std::make_pair("ab %5b %8E %aa", "ab%20%5B%20%8E%20%AA"),
+
+            // Non-ASCII bytes are encoded one by one.
+            std::make_pair("caf\xC3\xA9", "caf%C3%A9"),
+            std::make_pair("\xE2\x82\xAC/%e2%82%ac", "%E2%82%AC/%E2%82%AC")
         )
 );
 
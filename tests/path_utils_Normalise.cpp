@@ -40,7 +40,14 @@ INSTANTIATE_TEST_SUITE_P(
             std::make_pair("ab%61%63%7A", "abacz"),
             std::make_pair("%2D%2E%5F%7E", "-._~"),
             std::make_pair("<generic>", "%3Cgeneric%3E"),
-            std::make_pair("ab %5b %8E %aa", "ab%20%5B%20%8E%20%AA")
+            std::make_pair("ab %5b %8E %aa", "ab%20%5B%20%8E%20%AA"),
+            std::make_pair("a//b", "a//b"),
+            std::make_pair("/a/../..", ""),
+            std::make_pair("/a/../b", "/b"),
+            std::make_pair("a/%2E/b", "a/b"),
+            std::make_pair("a/%2e%2E/b", "b"),
+            std::make_pair("a b/../c d", "c%20d"),
+            std::make_pair("caf\xC3\xA9/./x/..", "caf%C3%A9")
         )
 );
 
@@ -52,3 +59,13 @@ TEST_P(PathUtilsNormaliseTestingFixture, NormaliseReturnsRightSegmentation) {
 
     EXPECT_EQ(uri::path::Normalise(path), expected_path);
 }
+
+TEST_P(PathUtilsNormaliseTestingFixture, NormaliseInPlaceReturnsRightSegmentation) {
+    const auto& pair = GetParam();
+
+    std::string path = pair.first;
+    const auto& expected_path = pair.second;
+
+    uri::path::NormaliseInPlace(path);
+    EXPECT_EQ(path, expected_path);
+}
@@ -36,3 +36,40 @@ TEST_P(PathUtilsRemoveDotSegmentsTestingFixture, RemoveDotSegmentsReturnsRightSe
 
     EXPECT_EQ(uri::path::RemoveDotSegments(input), expected_segments);
 }
+
+using PathTestPayload = std::pair<std::string, std::string>;
+class PathUtilsRemoveDotSegmentsOfPathTestingFixture: public ::testing::TestWithParam<PathTestPayload> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        PathUtilsTests,
+        PathUtilsRemoveDotSegmentsOfPathTestingFixture,
+        ::testing::Values(
+            std::make_pair("", ""),
+            std::make_pair("/", "/"),
+            std::make_pair(".", ""),
+            std::make_pair("..", ""),
+            std::make_pair("/.", "/"),
+            std::make_pair("/..", "/"),
+            std::make_pair("a/", "a/"),
+            std::make_pair("/a/b/c/./../../g", "/a/g"),
+            std::make_pair("mid/content=5/../6", "mid/6"),
+            std::make_pair("/a/b/c/../../../../g", "/g"),
+            std::make_pair("/a/b/..", "/a/"),
+            std::make_pair("/a/b/.", "/a/b/"),
+            std::make_pair("../../a/./b", "a/b"),
+            std::make_pair("/a//../b", "/a/b"),
+            std::make_pair("/a/.b/..c/b..", "/a/.b/..c/b..")
+        )
+);
+
+TEST_P(PathUtilsRemoveDotSegmentsOfPathTestingFixture, RemoveDotSegmentsFollowsRfc3986) {
+    const auto& pair = GetParam();
+
+    std::string path = pair.first;
+    const auto& expected_path = pair.second;
+
+    char* end = uri::path::RemoveDotSegments(path, path.data());
+    path.resize(static_cast<size_t>(end - path.data()));
+    EXPECT_EQ(path, expected_path);
+    EXPECT_EQ(uri::path::HasDotSegments(pair.first), pair.first != expected_path);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "pct_coding.h"
+#include "pct_encoding.h"
+
+using uri::EncodeSet;
+
+namespace {
+
+// Byte-at-a-time reference of uri::decode.
+std::string DecodeReference(const std::string& input) {
+    auto hex = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+
+    std::string out;
+    for (size_t i = 0; i < input.length(); i++) {
+        if (input[i] == '%' && i + 2 < input.length() && hex(input[i + 1]) >= 0 && hex(input[i + 2]) >= 0) {
+            out.push_back(static_cast<char>(hex(input[i + 1]) * 16 + hex(input[i + 2])));
+            i += 2;
+        } else {
+            out.push_back(input[i]);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+using TestPayload = std::pair<std::string, std::string>;
+
+class PctDecodeTestingFixture: public ::testing::TestWithParam<TestPayload> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        PctEncodingTests,
+        PctDecodeTestingFixture,
+        ::testing::Values(
+            std::make_pair("", ""),
+            std::make_pair("abc", "abc"),
+            std::make_pair("a%20b", "a b"),
+            std::make_pair("%41%62%7a", "Abz"),
+            std::make_pair("100%", "100%"),
+            std::make_pair("%%41", "%A"),
+            std::make_pair("%4", "%4"),
+            std::make_pair("%zz%2", "%zz%2"),
+            std::make_pair("%E2%82%AC", "\xE2\x82\xAC"),
+            // Long enough runs for the vector kernel.
+            std::make_pair("%E2%82%AC%E2%82%AC%E2%82%AC%E2%82%AC", "\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC"),
+            std::make_pair("x%48%65%6c%6C%6f%2C%20%57%6F%72%6c%64%21y", "xHello, World!y"),
+            std::make_pair("%41%42%43%44%4G%45%46%47%48%49%4a%4b", "ABCD%4GEFGHIJK"),
+            std::make_pair("%00%ff%FF%80%7f%0a%0A%9b%9B%c0%C0%e9%E9", std::string("\x00\xFF\xFF\x80\x7F\x0A\x0A\x9B\x9B\xC0\xC0\xE9\xE9", 13)),
+            // Plain text that looks like hex digits right after a run.
+            std::make_pair("%20%20%20%20%20abc", "     abc"),
+            std::make_pair("%41%41%41%41%41B12", "AAAAAB12"),
+            std::make_pair("%20%20%20%20%20%20abc", "      abc"),
+            std::make_pair("%20%20%20%20%20%20%20%20%20%20abc", "          abc"),
+            std::make_pair("%20%20%20%20%20%20%20%20%20%20%20fed", "           fed")
+        )
+);
+
+TEST_P(PctDecodeTestingFixture, DecodeReturnsDecodedText) {
+    const auto& pair = GetParam();
+
+    EXPECT_EQ(uri::decode(pair.first), pair.second);
+}
+
+TEST(PctEncodingTests, EncodeKeepsOnlyTheCharactersOfTheSet) {
+    EXPECT_EQ(uri::encode<EncodeSet::kPath>("/a b/c%d"), "/a%20b/c%25d");
+    EXPECT_EQ(uri::encode<EncodeSet::kSegment>("a/b:c@d"), "a%2Fb:c@d");
+    EXPECT_EQ(uri::encode<EncodeSet::kQuery>("a=1&b=/?#"), "a=1&b=/?%23");
+    EXPECT_EQ(uri::encode<EncodeSet::kQueryParam>("a=1&b+c"), "a%3D1%26b%2Bc");
+    EXPECT_EQ(uri::encode<EncodeSet::kFragment>("top [1]"), "top%20%5B1%5D");
+    EXPECT_EQ(uri::encode<EncodeSet::kUserInfo>("user:p@ss"), "user:p%40ss");
+    EXPECT_EQ(uri::encode<EncodeSet::kHost>("ex ample.com:80"), "ex%20ample.com%3A80");
+    EXPECT_EQ(uri::encode<EncodeSet::kPath>("\xE2\x82\xAC"), "%E2%82%AC");
+    EXPECT_EQ(uri::encode<EncodeSet::kPath>(""), "");
+}
+
+TEST(PctEncodingTests, EncodedTextDecodesBack) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> bytes(0, 255);
+    // Runs of encoded bytes long enough for the vector kernel,
+    // next to plain text that looks like hex digits.
+    const std::string hex_digits = "0123456789abcdef";
+    std::uniform_int_distribution<size_t> hex_digit(0, hex_digits.length() - 1);
+    std::uniform_int_distribution<size_t> run_length(0, 12);
+
+    for (size_t length = 0; length < 200; length++) {
+        std::string text;
+        while (text.length() < length) {
+            if (random() % 2 == 0) {
+                for (size_t i = run_length(random); i > 0; i--) {
+                    text.push_back(static_cast<char>(bytes(random)));
+                }
+            } else {
+                for (size_t i = run_length(random) % 4 + 1; i > 0; i--) {
+                    text.push_back(hex_digits[hex_digit(random)]);
+                }
+            }
+        }
+
+        const auto& encoded = uri::encode<EncodeSet::kQueryParam>(text);
+        EXPECT_EQ(uri::decode(encoded), text) << encoded;
+        EXPECT_EQ(uri::decode(encoded), DecodeReference(encoded));
+    }
+}
+
+TEST(PctEncodingTests, DecodeMatchesReference) {
+    std::mt19937 random(7);
+    // Mostly percent signs and hex digits to produce runs and broken triplets.
+    const std::string alphabet = "%%%%%%0123456789abcdefABCDEFgz/";
+    std::uniform_int_distribution<size_t> symbols(0, alphabet.length() - 1);
+
+    for (size_t attempt = 0; attempt < 2000; attempt++) {
+        std::string text;
+        for (size_t i = 0; i < attempt % 97; i++) {
+            text.push_back(alphabet[symbols(random)]);
+        }
+
+        ASSERT_EQ(uri::decode(text), DecodeReference(text)) << text;
+    }
+}
+
+TEST(PctEncodingTests, NormalisedLengthIsExact) {
+    const std::string text = "a%7e%41 %5b/%zz%";
+    std::string out;
+    uri::__internal::AppendPctNormalised(text, uri::__internal::kPathCodingSet, out);
+
+    EXPECT_EQ(out, "a~A%20%5B/%25zz%25");
+    EXPECT_EQ(out.length(), uri::__internal::PctNormalisedLength(text, uri::__internal::kPathCodingSet));
+}
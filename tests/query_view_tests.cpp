@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "query_view.h"
+#include "url.h"
+
+using uri::QueryView;
+
+using query_items_t = std::vector<std::pair<std::string_view, std::string_view>>;
+
+using TestPayload = std::pair<std::string, query_items_t>;
+class QueryViewTestingFixture: public ::testing::TestWithParam<TestPayload> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        QueryViewIterationTests,
+        QueryViewTestingFixture,
+        ::testing::Values(
+            std::make_pair("", query_items_t()),
+            std::make_pair("&&&", query_items_t()),
+            std::make_pair("q=5", query_items_t({ {"q", "5"} })),
+            std::make_pair("q=5&&", query_items_t({ {"q", "5"} })),
+            std::make_pair("&&q=5", query_items_t({ {"q", "5"} })),
+            std::make_pair("q1=9.88&a=b&re=t", query_items_t({ {"q1", "9.88"}, {"a", "b"}, {"re", "t"} })),
+            std::make_pair("a=hello&b=&", query_items_t({ {"a", "hello"}, {"b", ""} })),
+            std::make_pair("hello=world&=&==", query_items_t({ {"hello", "world"}, {"", ""}, {"", "="} })),
+            std::make_pair("===", query_items_t({ {"", "=="} })),
+            std::make_pair("flag&a=1&a=2", query_items_t({ {"flag", ""}, {"a", "1"}, {"a", "2"} }))
+        )
+);
+
+TEST_P(QueryViewTestingFixture, TestThatItemsAreYieldedInOrder) {
+    const auto& pair = GetParam();
+
+    const QueryView view(pair.first);
+
+    query_items_t actual_items;
+    for (const auto& item: view) {
+        actual_items.push_back(item);
+    }
+
+    EXPECT_EQ(actual_items, pair.second);
+    EXPECT_EQ(view.empty(), pair.second.empty());
+}
+
+TEST(QueryViewTests, ItemsPointIntoTheQuery) {
+    const std::string query = "a=1&b=2";
+    const QueryView view(query);
+
+    const auto& item = *(++view.begin());
+    EXPECT_EQ(item.first.data(), query.data() + 4);
+    EXPECT_EQ(item.second.data(), query.data() + 6);
+}
+
+TEST(QueryViewTests, FindReturnsTheFirstValue) {
+    const QueryView view("a=1&b=2&a=3");
+
+    EXPECT_EQ(view.find("a").value(), "1");
+    EXPECT_EQ(view.find("b").value(), "2");
+    EXPECT_FALSE(view.find("c"));
+}
+
+TEST(QueryViewTests, QueryViewIsConstexpr) {
+    constexpr QueryView view("a=1&b=2");
+    static_assert(view.find("b").value() == "2");
+    static_assert(!QueryView().find("a"));
+}
+
+TEST(QueryViewTests, UrlQueryViewMatchesQueryParams) {
+    const auto url = uri::Url::parse("http://github.com/st235?a=1&b=&c").value();
+
+    const auto& view = url.getQueryView();
+    const auto& query = url.getQuery();
+    EXPECT_EQ(query_items_t(view.begin(), view.end()), query_items_t(query.begin(), query.end()));
+}
+
+TEST(QueryViewTests, UrlWithoutQueryHasEmptyView) {
+    EXPECT_TRUE(uri::Url::parse("http://github.com/st235").value().getQueryView().empty());
+    EXPECT_TRUE(uri::Url::parse("http://github.com/st235?").value().getQueryView().empty());
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "resolved_base.h"
+#include "uri.h"
+
+using uri::ResolvedBase;
+using uri::Uri;
+
+namespace {
+
+constexpr char kRfcBase[] = "http://a/b/c/d;p?q";
+
+// A path of random segments, including empty ones, dot segments
+// and ones with a colon that cannot start a relative path.
+std::string RandomPath(std::mt19937& generator) {
+    static constexpr const char* kSegments[] = { "a", "b", "", "", "..", ".", "c:d", "e:" };
+
+    std::uniform_int_distribution<size_t> segment(0, std::size(kSegments) - 1);
+    std::uniform_int_distribution<size_t> length(0, 6);
+
+    std::string path;
+    for (size_t i = length(generator); i > 0; i--) {
+        path.push_back('/');
+        path.append(kSegments[segment(generator)]);
+    }
+    return path;
+}
+
+
+} // namespace
+
+class ResolvedBaseTestingFixture: public ::testing::TestWithParam<std::pair<std::string, std::string>> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        ResolvedBaseTests,
+        ResolvedBaseTestingFixture,
+        ::testing::Values(
+            // Normal examples, see RFC3986 section 5.4.1.
+            std::make_pair("g:h", "g:h"),
+            std::make_pair("g", "http://a/b/c/g"),
+            std::make_pair("./g", "http://a/b/c/g"),
+            std::make_pair("g/", "http://a/b/c/g/"),
+            std::make_pair("/g", "http://a/g"),
+            std::make_pair("//g", "http://g"),
+            std::make_pair("?y", "http://a/b/c/d;p?y"),
+            std::make_pair("g?y", "http://a/b/c/g?y"),
+            std::make_pair("#s", "http://a/b/c/d;p?q#s"),
+            std::make_pair("g#s", "http://a/b/c/g#s"),
+            std::make_pair("g?y#s", "http://a/b/c/g?y#s"),
+            std::make_pair(";x", "http://a/b/c/;x"),
+            std::make_pair("g;x", "http://a/b/c/g;x"),
+            std::make_pair("g;x?y#s", "http://a/b/c/g;x?y#s"),
+            std::make_pair("", "http://a/b/c/d;p?q"),
+            std::make_pair(".", "http://a/b/c/"),
+            std::make_pair("./", "http://a/b/c/"),
+            std::make_pair("..", "http://a/b/"),
+            std::make_pair("../", "http://a/b/"),
+            std::make_pair("../g", "http://a/b/g"),
+            std::make_pair("../..", "http://a/"),
+            std::make_pair("../../", "http://a/"),
+            std::make_pair("../../g", "http://a/g"),
+            // Abnormal examples, see RFC3986 section 5.4.2.
+            std::make_pair("../../../g", "http://a/g"),
+            std::make_pair("../../../../g", "http://a/g"),
+            std::make_pair("/./g", "http://a/g"),
+            std::make_pair("/../g", "http://a/g"),
+            std::make_pair("g.", "http://a/b/c/g."),
+            std::make_pair(".g", "http://a/b/c/.g"),
+            std::make_pair("g..", "http://a/b/c/g.."),
+            std::make_pair("..g", "http://a/b/c/..g"),
+            std::make_pair("./../g", "http://a/b/g"),
+            std::make_pair("./g/.", "http://a/b/c/g/"),
+            std::make_pair("g/./h", "http://a/b/c/g/h"),
+            std::make_pair("g/../h", "http://a/b/c/h"),
+            std::make_pair("g;x=1/./y", "http://a/b/c/g;x=1/y"),
+            std::make_pair("g;x=1/../y", "http://a/b/c/y"),
+            std::make_pair("g?y/./x", "http://a/b/c/g?y/./x"),
+            std::make_pair("g?y/../x", "http://a/b/c/g?y/../x"),
+            std::make_pair("g#s/./x", "http://a/b/c/g#s/./x"),
+            std::make_pair("g#s/../x", "http://a/b/c/g#s/../x"),
+            // A strict parser keeps the scheme of the reference.
+            std::make_pair("http:g", "http:g")
+        )
+);
+
+TEST_P(ResolvedBaseTestingFixture, ResolveFollowsRfc3986Examples) {
+    const auto& pair = GetParam();
+
+    const auto base = ResolvedBase::parse(kRfcBase);
+    ASSERT_TRUE(base);
+
+    const auto target = base->resolve(pair.first);
+    ASSERT_TRUE(target);
+    EXPECT_EQ(target->toString(), pair.second);
+    EXPECT_EQ(target.value(), Uri::parse(pair.second).value());
+
+    const auto reference = Uri::parse(pair.first);
+    ASSERT_TRUE(reference);
+    EXPECT_EQ(Uri::resolve(Uri::parse(kRfcBase).value(), reference.value()), target);
+}
+
+TEST(ResolvedBaseTests, BaseHasToBeAbsolute) {
+    EXPECT_FALSE(ResolvedBase::parse("/b/c/d;p?q"));
+    EXPECT_FALSE(ResolvedBase::parse("http://a/b c"));
+    EXPECT_FALSE(Uri::resolve(Uri::parse("//a/b").value(), Uri::parse("g").value()));
+}
+
+TEST(ResolvedBaseTests, InvalidReferenceHasNoTarget) {
+    const auto base = ResolvedBase::parse(kRfcBase);
+    ASSERT_TRUE(base);
+    EXPECT_FALSE(base->resolve("g h"));
+    EXPECT_FALSE(base->resolve("%zz"));
+}
+
+TEST(ResolvedBaseTests, BasePathIsFreeOfDotSegments) {
+    const auto base = ResolvedBase::parse("http://a/b/./c/../d?q");
+    ASSERT_TRUE(base);
+    EXPECT_EQ(base->getPath(), "/b/d");
+    EXPECT_EQ(base->resolve("g")->toString(), "http://a/b/g");
+    EXPECT_EQ(base->resolve("")->toString(), "http://a/b/d?q");
+}
+
+TEST(ResolvedBaseTests, EmptyBasePathIsMergedAsRoot) {
+    const auto base = ResolvedBase::parse("http://a");
+    ASSERT_TRUE(base);
+    EXPECT_EQ(base->resolve("g")->toString(), "http://a/g");
+    EXPECT_EQ(base->resolve("?y")->toString(), "http://a?y");
+}
+
+TEST(ResolvedBaseTests, BaseWithoutAuthority) {
+    const auto base = ResolvedBase::parse("urn:example:a/b");
+    ASSERT_TRUE(base);
+    EXPECT_EQ(base->resolve("c")->toString(), "urn:example:a/c");
+    EXPECT_EQ(base->resolve("../../c")->toString(), "urn:/c");
+
+    // "//" would start an authority.
+    const auto rooted = ResolvedBase::parse("foo:/a/b");
+    ASSERT_TRUE(rooted);
+    EXPECT_EQ(rooted->resolve(".//g")->toString(), "foo:/a//g");
+    EXPECT_EQ(rooted->resolve("..//g")->toString(), "foo:/.//g");
+}
+
+TEST(ResolvedBaseTests, LongPathsAreResolved) {
+    const auto base = ResolvedBase::parse("http://a/" + std::string(600, 'b') + "/c");
+    ASSERT_TRUE(base);
+
+    const std::string reference = std::string(700, 'g') + "/../h";
+    EXPECT_EQ(base->resolve(reference)->toString(), "http://a/" + std::string(600, 'b') + "/h");
+}
+
+TEST(ResolvedBaseTests, TargetIsAllocatedOnce) {
+    const auto base = ResolvedBase::parse(kRfcBase);
+    ASSERT_TRUE(base);
+
+    std::array<std::byte, 256> buffer;
+    std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    const Uri target = base->resolve(Uri::parse("../g?y#s").value(), &resource);
+    EXPECT_EQ(target.toString(), "http://a/b/g?y#s");
+    EXPECT_EQ(target.get_allocator().resource(), &resource);
+}
+
+class ResolvedBaseRelativizeTestingFixture: public ::testing::TestWithParam<std::pair<std::string, std::string>> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        ResolvedBaseTests,
+        ResolvedBaseRelativizeTestingFixture,
+        ::testing::Values(
+            std::make_pair("http://a/b/c/g", "g"),
+            std::make_pair("http://a/b/c/g/", "g/"),
+            std::make_pair("http://a/b/c/g?y#s", "g?y#s"),
+            std::make_pair("http://a/b/c/d;p?q", ""),
+            std::make_pair("http://a/b/c/d;p?q#s", "#s"),
+            std::make_pair("http://a/b/c/d;p?y", "?y"),
+            std::make_pair("http://a/b/c/d;p", "d;p"),
+            std::make_pair("http://a/b/c/", "."),
+            std::make_pair("http://a/b/", ".."),
+            std::make_pair("http://a/b/g", "../g"),
+            std::make_pair("http://a/", "/"),
+            std::make_pair("http://a/g/h", "/g/h"),
+            std::make_pair("http://a/b/c/g:h", "./g:h"),
+            std::make_pair("http://a/b/c//g", ".//g"),
+            std::make_pair("http://a", "//a"),
+            std::make_pair("http://g/x?y", "//g/x?y"),
+            std::make_pair("http://a:80/b/c/g", "//a:80/b/c/g"),
+            std::make_pair("https://a/b/c/g", "https://a/b/c/g"),
+            std::make_pair("mailto:someone@example.com", "mailto:someone@example.com"),
+            std::make_pair("http://a/b/c/./g/../h", "h")
+        )
+);
+
+TEST_P(ResolvedBaseRelativizeTestingFixture, RelativizeReturnsShortestReference) {
+    const auto& pair = GetParam();
+
+    const auto base = ResolvedBase::parse(kRfcBase);
+    ASSERT_TRUE(base);
+
+    const auto target = Uri::parse(pair.first);
+    ASSERT_TRUE(target);
+
+    const auto reference = base->relativize(target.value());
+    ASSERT_TRUE(reference);
+    EXPECT_EQ(reference->toString(), pair.second);
+    EXPECT_EQ(Uri::relativize(Uri::parse(kRfcBase).value(), target.value()), reference);
+
+    // Resolves back to the target without dot segments.
+    EXPECT_EQ(base->resolve(reference.value()), base->resolve(target.value()));
+}
+
+TEST(ResolvedBaseTests, RelativeTargetHasNoReference) {
+    const auto base = ResolvedBase::parse(kRfcBase);
+    ASSERT_TRUE(base);
+    EXPECT_FALSE(base->relativize(Uri::parse("../g").value()));
+}
+
+TEST(ResolvedBaseTests, RelativizedReferencesResolveBack) {
+    const auto base = ResolvedBase::parse("http://u@a:8080/b//c/d?q");
+    ASSERT_TRUE(base);
+
+    for (const auto& input: { "g", "./g:h", "..//g", "../../..//g", "/", "//a", "?y", "#s", "", ".", "..", "/b//c/d", "/b/c/d", "ftp://a/b" }) {
+        const auto target = base->resolve(input);
+        ASSERT_TRUE(target) << input;
+
+        const auto reference = base->relativize(target.value());
+        ASSERT_TRUE(reference) << input;
+        EXPECT_EQ(base->resolve(reference.value()), target.value()) << input << " " << reference.value();
+    }
+}
+
+TEST(ResolvedBaseTests, RandomRelativizedReferencesResolveBack) {
+    std::mt19937 generator(1234);
+
+    for (size_t iteration = 0; iteration < 2000; iteration++) {
+        const std::string base_text = "http://a" + RandomPath(generator) + "?q";
+        const auto base = ResolvedBase::parse(base_text);
+        ASSERT_TRUE(base) << base_text;
+
+        // Targets are resolved, so they have no dot segments left.
+        std::string target_text = (generator() % 4 == 0 ? "http://b" : "http://a") + RandomPath(generator);
+        if (generator() % 2 == 0) {
+            target_text.append("?y");
+        }
+        if (generator() % 4 == 0) {
+            target_text.append("#s");
+        }
+        const auto target = base->resolve(target_text);
+        ASSERT_TRUE(target) << target_text;
+
+        const auto reference = base->relativize(target.value());
+        ASSERT_TRUE(reference) << base_text << " " << target.value();
+        EXPECT_EQ(base->resolve(reference.value()), target.value())
+            << base_text << " " << target.value() << " " << reference.value();
+    }
+}
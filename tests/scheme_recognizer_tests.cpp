@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+#include "authority.h"
+#include "scheme_id.h"
+#include "detail/scheme_recognizer.h"
+#include "uri.h"
+#include "detail/uri_state_machine.h"
+#include "uri_view.h"
+#include "url.h"
+
+using uri::SchemeId;
+using uri::Uri;
+using uri::UriView;
+using uri::__internal::RecognizeScheme;
+
+static_assert(RecognizeScheme("HTTPS") == SchemeId::kHttps, "Schemes are recognised at compile time.");
+
+class SchemeRecognizerTestingFixture: public ::testing::TestWithParam<std::pair<std::string, SchemeId>> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        SchemeRecognizerTests,
+        SchemeRecognizerTestingFixture,
+        ::testing::Values(
+            std::make_pair("http", SchemeId::kHttp),
+            std::make_pair("https", SchemeId::kHttps),
+            std::make_pair("ws", SchemeId::kWs),
+            std::make_pair("wss", SchemeId::kWss),
+            std::make_pair("ftp", SchemeId::kFtp),
+            std::make_pair("file", SchemeId::kFile),
+            std::make_pair("mailto", SchemeId::kMailto),
+            std::make_pair("data", SchemeId::kData),
+            std::make_pair("urn", SchemeId::kUrn),
+            std::make_pair("HTTP", SchemeId::kHttp),
+            std::make_pair("HtTpS", SchemeId::kHttps),
+            std::make_pair("MailTo", SchemeId::kMailto),
+            std::make_pair("h", SchemeId::kOther),
+            std::make_pair("htt", SchemeId::kOther),
+            std::make_pair("httpss", SchemeId::kOther),
+            std::make_pair("http2", SchemeId::kOther),
+            std::make_pair("xhttp", SchemeId::kOther),
+            std::make_pair("mailtox", SchemeId::kOther),
+            std::make_pair("svn+ssh", SchemeId::kOther),
+            std::make_pair("coap.tcp", SchemeId::kOther),
+            std::make_pair("httpsssss", SchemeId::kOther),
+            std::make_pair("https-with-a-long-name", SchemeId::kOther)
+        )
+);
+
+TEST_P(SchemeRecognizerTestingFixture, WellKnownSchemesAreRecognised) {
+    const auto& pair = GetParam();
+
+    EXPECT_EQ(RecognizeScheme(pair.first), pair.second);
+
+    const std::string input = pair.first + "://example.com/a";
+    const auto uri = Uri::parse(input);
+    ASSERT_TRUE(uri);
+    EXPECT_EQ(uri->getSchemeId(), pair.second);
+    EXPECT_EQ(uri->normalised().getSchemeId(), pair.second);
+    EXPECT_EQ(UriView::parse(input)->getSchemeId(), pair.second);
+    EXPECT_EQ(uri::Url::parse(input)->getSchemeId(), pair.second);
+
+    const Uri built(pair.first, uri::Authority("example.com"), "/a");
+    EXPECT_EQ(built.getSchemeId(), pair.second);
+    EXPECT_EQ(built.toView().getSchemeId(), pair.second);
+    EXPECT_EQ(UriView(pair.first, uri::AuthorityView("example.com"), "/a").getSchemeId(), pair.second);
+
+    // The scheme is recognised however the input is split.
+    for (size_t split = 0; split <= pair.first.length() + 1; split++) {
+        uri::__internal::UriStateMachine machine;
+        ASSERT_TRUE(machine.feed(std::string_view(input).substr(0, split)));
+        ASSERT_TRUE(machine.feed(std::string_view(input).substr(split)));
+        ASSERT_TRUE(machine.finish());
+        EXPECT_EQ(machine.getSchemeId(), pair.second) << split;
+    }
+}
+
+TEST(SchemeRecognizerTests, ReferencesWithoutSchemeHaveNone) {
+    for (const auto& input: { "//example.com/a", "/a/b", "a/b", "http", "?q", "" }) {
+        EXPECT_EQ(Uri::parse(input)->getSchemeId(), SchemeId::kNone) << input;
+        EXPECT_EQ(UriView::parse(input)->getSchemeId(), SchemeId::kNone) << input;
+    }
+    EXPECT_EQ(Uri("/a").getSchemeId(), SchemeId::kNone);
+}
+
+TEST(SchemeRecognizerTests, SchemesHaveLowercaseNames) {
+    EXPECT_EQ(uri::SchemeNameOf(SchemeId::kHttps), "https");
+    EXPECT_EQ(uri::SchemeNameOf(SchemeId::kMailto), "mailto");
+    EXPECT_TRUE(uri::SchemeNameOf(SchemeId::kOther).empty());
+    EXPECT_TRUE(uri::SchemeNameOf(SchemeId::kNone).empty());
+
+    EXPECT_EQ(Uri::parse("HTTPS://Example.com/")->normalised().getScheme(), "https");
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "uri_batch.h"
+
+using uri::UriBatch;
+
+namespace {
+
+std::vector<std::string> GenerateInputs(size_t count) {
+    std::vector<std::string> inputs;
+    inputs.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (i % 7 == 3) {
+            inputs.push_back("http://[::" + std::to_string(i) + "/broken");
+        } else {
+            inputs.push_back("https://host" + std::to_string(i) + ".example.com:" + std::to_string(i % 1000) + "/p?q=" + std::to_string(i));
+        }
+    }
+    return inputs;
+}
+
+void ExpectSameBatches(const UriBatch& actual, const UriBatch& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_EQ(actual.getValidityBitmap(), expected.getValidityBitmap());
+    EXPECT_EQ(actual.getPresence(), expected.getPresence());
+    EXPECT_EQ(actual.getHostTypes(), expected.getHostTypes());
+    for (size_t component = 0; component < UriBatch::kComponentsCount; component++) {
+        EXPECT_EQ(actual.getOffsets(static_cast<UriBatch::Component>(component)),
+                  expected.getOffsets(static_cast<UriBatch::Component>(component)));
+        EXPECT_EQ(actual.getLengths(static_cast<UriBatch::Component>(component)),
+                  expected.getLengths(static_cast<UriBatch::Component>(component)));
+    }
+}
+
+} // namespace
+
+class UriBatchParallelTestingFixture: public ::testing::TestWithParam<size_t> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        UriBatchParallelTests,
+        UriBatchParallelTestingFixture,
+        ::testing::Values(1, 2, 3, 8, 33)
+);
+
+TEST_P(UriBatchParallelTestingFixture, TestThatParallelParsingKeepsInputOrder) {
+    const auto& storage = GenerateInputs(20000);
+    const std::vector<std::string_view> inputs(storage.begin(), storage.end());
+
+    ExpectSameBatches(uri::parseBatchParallel(inputs, GetParam()), uri::parseBatch(inputs));
+}
+
+TEST(UriBatchParallelTests, EmptyInputIsParsed) {
+    const auto& batch = uri::parseBatchParallel(std::vector<std::string_view>(), 4);
+    EXPECT_EQ(batch.size(), 0);
+}
+
+TEST(UriBatchParallelTests, LinesAreSplitAndParsed) {
+    const auto& batch = uri::parseLinesParallel("https://a/b\r\nhttp://[::1/x\n\n//c:80", 2);
+
+    ASSERT_EQ(batch.size(), 4);
+    EXPECT_EQ(batch.getInput(0), "https://a/b");
+    EXPECT_TRUE(batch.isValid(0));
+    EXPECT_FALSE(batch.isValid(1));
+    EXPECT_EQ(batch.getInput(2), "");
+    EXPECT_TRUE(batch.isValid(2));
+    EXPECT_EQ(batch.getComponent(3, UriBatch::Component::kPort), "80");
+}
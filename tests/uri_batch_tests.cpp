@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+#include "uri_batch.h"
+#include "uri_view.h"
+
+using uri::UriBatch;
+using uri::UriView;
+
+namespace {
+
+const std::vector<std::string_view> kInputs = {
+    "https://user@example.com:8080/a/b?q=1#f",
+    "http://[::1/path",
+    "",
+    "//192.168.0.1/",
+    "//[v7.a:b]",
+    ":website.com?q=5",
+    "mailto:user@example.com",
+    "../relative?x",
+};
+
+} // namespace
+
+TEST(UriBatchTests, BatchMatchesPerUriParsing) {
+    const auto& batch = uri::parseBatch(kInputs);
+
+    ASSERT_EQ(batch.size(), kInputs.size());
+    for (size_t i = 0; i < kInputs.size(); i++) {
+        const auto& expected = UriView::parse(kInputs[i]);
+        EXPECT_EQ(batch.isValid(i), expected.has_value()) << kInputs[i];
+        EXPECT_EQ(batch.getView(i), expected) << kInputs[i];
+    }
+}
+
+TEST(UriBatchTests, ValidityBitmapMarksValidInputs) {
+    const auto& batch = uri::parseBatch(kInputs);
+
+    ASSERT_EQ(batch.getValidityBitmap().size(), 1);
+    EXPECT_EQ(batch.getValidityBitmap()[0], 0b11011101);
+}
+
+TEST(UriBatchTests, ComponentsAreStoredAsOffsetsAndLengths) {
+    const auto& batch = uri::parseBatch(kInputs);
+
+    EXPECT_EQ(batch.getOffsets(UriBatch::Component::kHost)[0], 13);
+    EXPECT_EQ(batch.getLengths(UriBatch::Component::kHost)[0], 11);
+    EXPECT_EQ(batch.getComponent(0, UriBatch::Component::kPort), "8080");
+
+    EXPECT_FALSE(batch.hasComponent(3, UriBatch::Component::kScheme));
+    EXPECT_EQ(batch.getLengths(UriBatch::Component::kScheme)[3], 0);
+    EXPECT_FALSE(batch.getComponent(3, UriBatch::Component::kScheme));
+}
+
+TEST(UriBatchTests, HostTypesAreRecorded) {
+    const auto& batch = uri::parseBatch(kInputs);
+
+    EXPECT_EQ(batch.getHostType(0), UriBatch::HostType::kRegName);
+    EXPECT_EQ(batch.getHostType(1), UriBatch::HostType::kNone);
+    EXPECT_EQ(batch.getHostType(2), UriBatch::HostType::kNone);
+    EXPECT_EQ(batch.getHostType(3), UriBatch::HostType::kIPv4);
+    EXPECT_EQ(batch.getHostType(4), UriBatch::HostType::kIPLiteral);
+}
+
+TEST(UriBatchTests, BatchIsReusedWithoutStaleResults) {
+    UriBatch batch;
+    uri::parseBatch(kInputs.data(), kInputs.size(), batch);
+
+    const std::vector<std::string_view> invalid = { "http://[::1/path" };
+    uri::parseBatch(invalid.data(), invalid.size(), batch);
+
+    ASSERT_EQ(batch.size(), 1);
+    EXPECT_FALSE(batch.isValid(0));
+    EXPECT_EQ(batch.getPresence()[0], 0);
+    EXPECT_EQ(batch.getHostType(0), UriBatch::HostType::kNone);
+}
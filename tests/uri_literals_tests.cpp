@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "uri_literals.h"
+#include "uri_view.h"
+
+using uri::AuthorityView;
+using uri::ParseUriView;
+using uri::UriView;
+using namespace uri::literals;
+
+// Validation happens at compile time.
+static_assert(ParseUriView("https://svc/x"));
+static_assert(ParseUriView("//user@[2001:db8::7]:8080/a?b#c"));
+static_assert(ParseUriView("../relative/path"));
+static_assert(!ParseUriView("http://[::1/path"));
+static_assert(!ParseUriView(":website.com?q=5"));
+static_assert(!ParseUriView("http://host/a b"));
+
+namespace {
+
+constexpr auto kEndpoint = "https://user@svc.example.com:8443/v1/items?limit=10#top"_uri;
+
+static_assert(kEndpoint.getScheme().value() == "https");
+static_assert(kEndpoint.getAuthority().value().getUserInfo().value() == "user");
+static_assert(kEndpoint.getAuthority().value().getHost() == "svc.example.com");
+static_assert(kEndpoint.getAuthority().value().getPort().value() == "8443");
+static_assert(kEndpoint.getPath() == "/v1/items");
+static_assert(kEndpoint.getQuery().value() == "limit=10");
+static_assert(kEndpoint.getFragment().value() == "top");
+
+constexpr auto kIPLiteral = "//[::1]/"_uri;
+
+static_assert(kIPLiteral.getAuthority().value().isHostIPLiteral());
+static_assert(kIPLiteral.getAuthority().value().getHost() == "::1");
+
+} // namespace
+
+TEST(UriLiteralsTests, LiteralMatchesRuntimeParsing) {
+    EXPECT_EQ(kEndpoint, UriView::parse("https://user@svc.example.com:8443/v1/items?limit=10#top").value());
+    EXPECT_EQ(kIPLiteral, UriView::parse("//[::1]/").value());
+}
+
+class UriLiteralsTestingFixture: public ::testing::TestWithParam<std::string> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        UriLiteralsTests,
+        UriLiteralsTestingFixture,
+        ::testing::Values(
+            "",
+            "mailto:user@example.com",
+            "http://192.168.0.1:80/",
+            "//[v7.a:b]",
+            "a+b.c:d",
+            "?q#f",
+            "http://[::1/path",
+            "1a:b"
+        )
+);
+
+TEST_P(UriLiteralsTestingFixture, TestThatConstexprParsingMatchesUriViewParse) {
+    const auto& text = GetParam();
+    EXPECT_EQ(ParseUriView(text), UriView::parse(text));
+}
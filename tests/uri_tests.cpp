@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstddef>
+#include <memory_resource>
 #include <string>
 #include <utility>
 
@@ -20,6 +23,12 @@ TEST(UriTests, UrisWithDifferentContentAreNotEqual) {
     EXPECT_NE(a, b);
 }
 
+TEST(UriTests, UriFromPartsKeepsQueryAndFragment) {
+    const auto& uri_opt = Uri::fromParts("/path", "https", "localhost", "q=1", "top");
+    ASSERT_TRUE(uri_opt);
+    EXPECT_EQ(uri_opt.value(), Uri("https", Authority("localhost"), "/path", "q=1", "top"));
+}
+
 class UriTestingFixture: public ::testing::TestWithParam<std::pair<std::string, Uri>> {};
 
 INSTANTIATE_TEST_SUITE_P(
@@ -126,3 +135,79 @@ TEST_P(UriSerialisationTestingFixture, TestThatH16ParsingIsCorrect) {
     sstream << uri;
     EXPECT_EQ(sstream.str(), expected_string);
 }
+
+TEST(UriTests, ComponentsAreViewsOfSingleBuffer) {
+    const auto& uri_opt = Uri::parse("https://user@[::1]:8080/a/b?q=1#top");
+    ASSERT_TRUE(uri_opt);
+
+    const auto& uri = uri_opt.value();
+    const auto& buffer = uri.toString();
+    EXPECT_EQ(buffer, "https://user@[::1]:8080/a/b?q=1#top");
+
+    const auto authority = uri.getAuthority().value();
+    EXPECT_EQ(uri.getScheme().value().data(), buffer.data());
+    EXPECT_EQ(authority.getUserInfo().value().data(), buffer.data() + 8);
+    EXPECT_EQ(authority.getHost(), "::1");
+    EXPECT_EQ(authority.getHost().data(), buffer.data() + 14);
+    EXPECT_EQ(authority.getPort().value(), "8080");
+    EXPECT_EQ(uri.getPath(), "/a/b");
+    EXPECT_EQ(uri.getQuery().value(), "q=1");
+    EXPECT_EQ(uri.getFragment().value(), "top");
+    EXPECT_EQ(uri.getHostType(), uri::HostType::kIPLiteral);
+}
+
+TEST(UriTests, ConstructedUriIsSerialisedOnce) {
+    Uri uri("http", Authority("example.com", "80", "user"), "/path", "q", "f");
+    EXPECT_EQ(uri.toString(), "http://user@example.com:80/path?q#f");
+    EXPECT_EQ(uri, Uri::parse("http://user@example.com:80/path?q#f").value());
+    EXPECT_EQ(uri.getHostType(), uri::HostType::kRegName);
+}
+
+TEST(UriTests, HostTypeOfConstructedUriIsRecognised) {
+    EXPECT_EQ(Uri("http", Authority("10.0.0.1"), "/").getHostType(), uri::HostType::kIPv4);
+    EXPECT_EQ(Uri("http", Authority("10.0.0.256"), "/").getHostType(), uri::HostType::kRegName);
+    EXPECT_EQ(Uri("/path").getHostType(), uri::HostType::kNone);
+}
+
+TEST(UriTests, EmptyComponentsAreKept) {
+    const auto uri = Uri::parse("s://@:?#").value();
+    EXPECT_EQ(uri.getScheme().value(), "s");
+    EXPECT_EQ(uri.getAuthority().value().getUserInfo().value(), "");
+    EXPECT_EQ(uri.getAuthority().value().getHost(), "");
+    EXPECT_EQ(uri.getAuthority().value().getPort().value(), "");
+    EXPECT_EQ(uri.getPath(), "");
+    EXPECT_EQ(uri.getQuery().value(), "");
+    EXPECT_EQ(uri.getFragment().value(), "");
+}
+
+TEST(UriTests, SameTextWithDifferentComponentsIsNotEqual) {
+    // "a:b" as a scheme and a path, and as a path only.
+    EXPECT_NE(Uri("a", std::optional<Authority>(), "b"), Uri("a:b"));
+}
+
+TEST(UriTests, UriIsCompact) {
+    // A buffer, 32-bit ends of the components, a few flags, the decoded
+    // host address and port number, and the hash.
+    EXPECT_LE(sizeof(Uri), sizeof(std::pmr::string) + 8 * sizeof(uint32_t) +
+                           sizeof(uri::IPv6Address) + 2 * sizeof(uint64_t));
+}
+
+TEST(UriTests, UriIsAllocatedWithTheGivenResource) {
+    std::array<std::byte, 1024> arena;
+    std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+    // Any allocation outside of the arena throws.
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    const auto& uri = Uri::parse("https://user@example.com:8080/a/long/enough/path/to/skip/sso?q=1#top", &resource);
+    const auto& constructed = Uri("https", Authority("example.com", "8080", std::nullopt, false, &resource),
+                                  "/a/long/enough/path/to/skip/sso", "q=1", "top", &resource);
+    const Uri copy(uri.value(), &resource);
+
+    std::pmr::set_default_resource(previous);
+
+    ASSERT_TRUE(uri);
+    EXPECT_EQ(uri.value().get_allocator().resource(), &resource);
+    EXPECT_EQ(constructed.get_allocator().resource(), &resource);
+    EXPECT_EQ(copy, uri.value());
+    EXPECT_EQ(copy.getAuthority().value().getHost(), "example.com");
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "uri.h"
+#include "uri_view.h"
+
+using uri::AuthorityView;
+using uri::Uri;
+using uri::UriView;
+
+namespace {
+
+bool IsWithin(std::string_view view, std::string_view buffer) {
+    return view.data() >= buffer.data() &&
+           view.data() + view.length() <= buffer.data() + buffer.length();
+}
+
+} // namespace
+
+TEST(UriViewTests, ViewsWithSameContentAreEqual) {
+    UriView a("https", AuthorityView("localhost"), "/path", "q=1", std::nullopt);
+    UriView b("https", AuthorityView("localhost"), "/path", "q=1", std::nullopt);
+    EXPECT_EQ(a, b);
+}
+
+TEST(UriViewTests, ViewsWithDifferentContentAreNotEqual) {
+    UriView a("https", AuthorityView("localhost"), "/path");
+    UriView b("ftp", AuthorityView("localhost"), "/path");
+    EXPECT_NE(a, b);
+}
+
+TEST(UriViewTests, InvalidUriIsNotParsed) {
+    EXPECT_FALSE(UriView::parse("http://[::1/path"));
+    EXPECT_FALSE(UriView::parse(":website.com?q=5"));
+}
+
+TEST(UriViewTests, ComponentsPointIntoTheInputBuffer) {
+    const std::string input = "https://user@example.com:8080/a/b?q=1#top";
+
+    const auto& view_opt = UriView::parse(input);
+    ASSERT_TRUE(view_opt);
+
+    const auto& view = view_opt.value();
+    const auto& authority = view.getAuthority().value();
+
+    EXPECT_TRUE(IsWithin(view.getScheme().value(), input));
+    EXPECT_TRUE(IsWithin(authority.getUserInfo().value(), input));
+    EXPECT_TRUE(IsWithin(authority.getHost(), input));
+    EXPECT_TRUE(IsWithin(authority.getPort().value(), input));
+    EXPECT_TRUE(IsWithin(view.getPath(), input));
+    EXPECT_TRUE(IsWithin(view.getQuery().value(), input));
+    EXPECT_TRUE(IsWithin(view.getFragment().value(), input));
+
+    EXPECT_EQ(view.getScheme().value().data(), input.data());
+    EXPECT_EQ(view.getPath().data(), input.data() + input.find("/a/b"));
+}
+
+TEST(UriViewTests, EmptyPathPointsIntoTheInputBuffer) {
+    const std::string input = "mailto:?to=someone";
+
+    const auto& view_opt = UriView::parse(input);
+    ASSERT_TRUE(view_opt);
+
+    EXPECT_EQ(view_opt.value().getPath(), "");
+    EXPECT_EQ(view_opt.value().getPath().data(), input.data() + input.find('?'));
+}
+
+class UriViewTestingFixture: public ::testing::TestWithParam<std::pair<std::string, Uri>> {};
+
+INSTANTIATE_TEST_SUITE_P(
+        UriViewParsingTests,
+        UriViewTestingFixture,
+        ::testing::Values(
+            std::make_pair("https://able@218.110.62.47/explore?q=keyword#section1", Uri("https", uri::Authority("218.110.62.47", std::nullopt, "able"), "/explore", "q=keyword", "section1")),
+            std::make_pair("http://often@[8c81:6c4f:3355:aea1:e2e7:22ba:ecf0:b427]/wp-content/tag?q=keyword#home", Uri("http", uri::Authority("8c81:6c4f:3355:aea1:e2e7:22ba:ecf0:b427", std::nullopt, "often", /* isHostIPLiteral= */ true), "/wp-content/tag", "q=keyword", "home")),
+            std::make_pair("https://12.150.26.161:63604/app/tags?filter=active", Uri("https", uri::Authority("12.150.26.161", "63604", std::nullopt), "/app/tags", "filter=active", std::nullopt)),
+            std::make_pair("/posts/tag/categories?search=query#section2", Uri(std::nullopt, std::nullopt, "/posts/tag/categories", "search=query", "section2")),
+            std::make_pair("a/b", Uri(std::nullopt, std::nullopt, "a/b", std::nullopt, std::nullopt))
+        )
+);
+
+TEST_P(UriViewTestingFixture, TestThatViewMatchesOwningUri) {
+    const auto& pair = GetParam();
+
+    const auto& input = pair.first;
+    const auto& expected_uri = pair.second;
+
+    const auto& view_opt = UriView::parse(input);
+    ASSERT_TRUE(view_opt);
+    EXPECT_EQ(Uri(view_opt.value()), expected_uri);
+
+    std::stringstream sstream;
+    sstream << view_opt.value();
+    EXPECT_EQ(sstream.str(), input);
+}
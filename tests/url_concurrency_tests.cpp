@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "url.h"
+
+using uri::Url;
+
+TEST(UrlConcurrencyTests, ConcurrentReadersSeeTheSameQuery) {
+    for (size_t attempt = 0; attempt < 100; attempt++) {
+        const auto url = Url::parse("/search?q=uri&page=2&tag=a&tag=b").value();
+
+        std::vector<const Url::query_params_t*> seen(4, nullptr);
+        std::vector<std::thread> readers;
+        for (size_t i = 0; i < seen.size(); i++) {
+            readers.emplace_back([&url, &seen, i]() {
+                seen[i] = &url.getQuery();
+            });
+        }
+
+        for (auto& reader: readers) {
+            reader.join();
+        }
+
+        for (const auto* query_params: seen) {
+            EXPECT_EQ(query_params, &url.getQuery());
+        }
+        EXPECT_EQ(url.getQuery().findAll("tag").size(), 2U);
+    }
+}
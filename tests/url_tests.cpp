@@ -1,30 +1,37 @@
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
 #include <string>
+#include <string_view>
 #include <utility>
-#include <unordered_map>
+#include <vector>
 
 #include "url.h"
 
 using uri::Url;
 
-using query_params_t = std::unordered_map<std::string, std::string>;
+using query_items_t = std::vector<std::pair<std::string_view, std::string_view>>;
 
-using TestPayload = std::pair<std::string, query_params_t>;
+using TestPayload = std::pair<std::string, query_items_t>;
 class UrlQueryTestingFixture: public ::testing::TestWithParam<TestPayload> {};
 
 INSTANTIATE_TEST_SUITE_P(
         UrlQueryParsingTests,
         UrlQueryTestingFixture,
         ::testing::Values(
-            std::make_pair("http://github.com/st235?q=5", query_params_t({ {"q", "5"} })),
-            std::make_pair("http://github.com/st235?q=5&&", query_params_t({ {"q", "5"} })),
-            std::make_pair("http://github.com/st235?q1=9.88&a=b&re=t", query_params_t({ {"q1", "9.88"}, {"a", "b"}, {"re", "t"} })),
-            std::make_pair("http://github.com/st235?a=hello&b=&", query_params_t({ {"a", "hello"}, {"b", ""} })),
-            std::make_pair("http://github.com/st235?hello=world&=&", query_params_t({ {"hello", "world"}, {"", ""} })),
-            std::make_pair("http://github.com/st235?hello=world&=&==", query_params_t({ {"hello", "world"}, {"", "="} })),
-            std::make_pair("http://github.com/st235?===", query_params_t({ {"", "=="} })),
-            std::make_pair("/posts/tag/app/search#contact", query_params_t())
+            std::make_pair("http://github.com/st235?q=5", query_items_t({ {"q", "5"} })),
+            std::make_pair("http://github.com/st235?q=5&&", query_items_t({ {"q", "5"} })),
+            std::make_pair("http://github.com/st235?q1=9.88&a=b&re=t", query_items_t({ {"q1", "9.88"}, {"a", "b"}, {"re", "t"} })),
+            std::make_pair("http://github.com/st235?a=hello&b=&", query_items_t({ {"a", "hello"}, {"b", ""} })),
+            std::make_pair("http://github.com/st235?hello=world&=&", query_items_t({ {"hello", "world"}, {"", ""} })),
+            std::make_pair("http://github.com/st235?hello=world&=&==", query_items_t({ {"hello", "world"}, {"", ""}, {"", "="} })),
+            std::make_pair("http://github.com/st235?b=2&a=1&b=3", query_items_t({ {"b", "2"}, {"a", "1"}, {"b", "3"} })),
+            std::make_pair("http://github.com/st235?===", query_items_t({ {"", "=="} })),
+            std::make_pair("/posts/tag/app/search#contact", query_items_t())
         )
 );
 
@@ -35,5 +42,124 @@ TEST_P(UrlQueryTestingFixture, TestThatH16ParsingIsCorrect) {
     const auto& actual_url = Url::parse(input);
     const auto& expected_query_params = pair.second;
 
-    EXPECT_EQ(actual_url.value().getQuery(), expected_query_params);
+    const auto& query = actual_url.value().getQuery();
+    EXPECT_EQ(query_items_t(query.begin(), query.end()), expected_query_params);
+}
+
+TEST(UrlTests, QueryParamsAreAllocatedWithTheGivenResource) {
+    std::array<std::byte, 4096> arena;
+    std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+    // Any allocation outside of the arena throws.
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    const auto& url = Url::parse("http://github.com/st235?a_key_long_enough_to_skip_sso=1&b=2", &resource);
+
+    std::pmr::set_default_resource(previous);
+
+    ASSERT_TRUE(url);
+    EXPECT_EQ(url.value().get_allocator().resource(), &resource);
+    EXPECT_EQ(url.value().getQuery().get_allocator().resource(), &resource);
+    EXPECT_EQ(url.value().getQuery().find("a_key_long_enough_to_skip_sso").value(), "1");
+    EXPECT_EQ(url.value().getQuery().find("b").value(), "2");
+}
+
+namespace {
+
+// Counts live allocations and fails once |remaining| reaches zero.
+class FailingResource: public std::pmr::memory_resource {
+public:
+    size_t live = 0;
+    size_t remaining = SIZE_MAX;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (remaining == 0) {
+            throw std::bad_alloc();
+        }
+        remaining--;
+        live++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        live--;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override {
+        return this == &that;
+    }
+};
+
+} // namespace
+
+TEST(UrlTests, FailedQueryParsingReleasesItsAllocation) {
+    FailingResource resource;
+
+    {
+        const auto& url = Url::parse("http://github.com/st235?a=1&b=2", &resource);
+        ASSERT_TRUE(url);
+
+        // The query params are allocated, building them fails.
+        const size_t live = resource.live;
+        resource.remaining = 1;
+        EXPECT_THROW(url.value().getQuery(), std::bad_alloc);
+        EXPECT_EQ(resource.live, live);
+
+        resource.remaining = SIZE_MAX;
+        EXPECT_EQ(url.value().getQuery().find("b").value(), "2");
+    }
+
+    EXPECT_EQ(resource.live, 0);
+}
+
+TEST(UrlTests, RepeatedKeysAreKeptInOrder) {
+    const auto url = Url::parse("/search?tag=a&page=2&tag=b&tag=").value();
+    const auto& query = url.getQuery();
+
+    EXPECT_EQ(query.size(), 4U);
+    EXPECT_EQ(query.find("tag").value(), "a");
+    EXPECT_EQ(query.findAll("tag"), std::vector<std::string_view>({ "a", "b", "" }));
+    EXPECT_EQ(query.find("page").value(), "2");
+    EXPECT_TRUE(query.findAll("missing").empty());
+    EXPECT_FALSE(query.contains("missing"));
+}
+
+TEST(UrlTests, QueryParamsOutliveMovedUrl) {
+    auto url = Url::parse("/?k=v").value();
+    const Url moved(std::move(url));
+
+    EXPECT_EQ(moved.getQuery().find("k").value(), "v");
+    EXPECT_EQ(moved.getQuery()[0], std::make_pair(std::string_view("k"), std::string_view("v")));
+}
+
+TEST(UrlTests, QueryIsParsedOnce) {
+    const auto url = Url::parse("/?a=1&b=2").value();
+
+    const auto& first = url.getQuery();
+    const auto& second = url.getQuery();
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(first.find("b").value(), "2");
+}
+
+TEST(UrlTests, MovedUrlKeepsParsedQuery) {
+    auto url = Url::parse("/?a=1&b=2").value();
+    const auto* query_params = &url.getQuery();
+
+    const Url moved(std::move(url));
+    EXPECT_EQ(&moved.getQuery(), query_params);
+
+    Url assigned("/");
+    assigned = Url(moved);
+    EXPECT_EQ(assigned.getQuery(), moved.getQuery());
+}
+
+TEST(UrlTests, CopiedUrlParsesQueryAgain) {
+    const auto url = Url::parse("/?a=1&b=2").value();
+    const auto& query_params = url.getQuery();
+
+    const Url copy(url);
+    EXPECT_NE(&copy.getQuery(), &query_params);
+    EXPECT_EQ(copy.getQuery(), query_params);
 }